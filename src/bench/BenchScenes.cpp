@@ -0,0 +1,324 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "BenchScenes.hpp"
+#include "lv2c/Lv2cFlexGridElement.hpp"
+#include "lv2c/Lv2cVerticalStackElement.hpp"
+#include "lv2c/Lv2cScrollContainerElement.hpp"
+#include "lv2c/Lv2cTypographyElement.hpp"
+#include "lv2c/Lv2cDialElement.hpp"
+#include "lv2c/Lv2cDbVuElement.hpp"
+#include "lv2c/Lv2cDropShadowElement.hpp"
+#include "lv2c/Lv2cMotionBlurElement.hpp"
+#include "lv2c/Lv2cSlideInOutAnimationElement.hpp"
+#include <cmath>
+#include <string>
+
+using namespace lv2c;
+using namespace lv2c::bench;
+
+namespace
+{
+    Lv2cFlexGridElement::ptr CreateGrid(Lv2cTheme::ptr theme)
+    {
+        auto grid = Lv2cFlexGridElement::Create();
+        grid->Style()
+            .Background(theme->paper)
+            .Padding({24, 16, 24, 16})
+            .HorizontalAlignment(Lv2cAlignment::Stretch)
+            .VerticalAlignment(Lv2cAlignment::Stretch)
+            .FlexDirection(Lv2cFlexDirection::Row)
+            .FlexWrap(Lv2cFlexWrap::Wrap)
+            .ColumnGap(16)
+            .RowGap(16);
+        return grid;
+    }
+
+    // Every control moves every frame.
+    class DialGridScene : public BenchScene
+    {
+    public:
+        virtual const char *Name() const override { return "dial_grid"; }
+        virtual Lv2cElement::ptr Create(Lv2cTheme::ptr theme) override
+        {
+            auto grid = CreateGrid(theme);
+            for (size_t i = 0; i < DIAL_COUNT; ++i)
+            {
+                auto dial = Lv2cDialElement::Create();
+                dial->Style().Width(48).Height(48);
+                dials.push_back(dial);
+                grid->AddChild(dial);
+            }
+            return grid;
+        }
+        virtual void Update(size_t frame) override
+        {
+            for (size_t i = 0; i < dials.size(); ++i)
+            {
+                dials[i]->Value(0.5 + 0.5 * std::sin(frame * 0.05 + i * 0.4));
+            }
+        }
+
+    private:
+        static constexpr size_t DIAL_COUNT = 64;
+        std::vector<Lv2cDialElement::ptr> dials;
+    };
+
+    class VuBankScene : public BenchScene
+    {
+    public:
+        virtual const char *Name() const override { return "vu_bank"; }
+        virtual Lv2cElement::ptr Create(Lv2cTheme::ptr theme) override
+        {
+            auto grid = CreateGrid(theme);
+            for (size_t i = 0; i < VU_COUNT; ++i)
+            {
+                auto vu = Lv2cDbVuElement::Create();
+                vu->MinValue(-60).MaxValue(6);
+                vu->Style().Height(240);
+                vus.push_back(vu);
+                grid->AddChild(vu);
+            }
+            return grid;
+        }
+        virtual void Update(size_t frame) override
+        {
+            for (size_t i = 0; i < vus.size(); ++i)
+            {
+                // Fast attack, with occasional peaks to exercise the peak-hold telltales.
+                double level = -30 + 24 * std::sin(frame * 0.13 + i * 0.7) * std::sin(frame * 0.031 + i);
+                vus[i]->Value(level);
+            }
+        }
+
+    private:
+        static constexpr size_t VU_COUNT = 32;
+        std::vector<Lv2cDbVuElement::ptr> vus;
+    };
+
+    class FileListScene : public BenchScene
+    {
+    public:
+        virtual const char *Name() const override { return "file_list"; }
+        virtual Lv2cElement::ptr Create(Lv2cTheme::ptr theme) override
+        {
+            scrollContainer = Lv2cScrollContainerElement::Create();
+            scrollContainer->Style()
+                .Background(theme->paper)
+                .HorizontalAlignment(Lv2cAlignment::Stretch)
+                .VerticalAlignment(Lv2cAlignment::Stretch);
+
+            auto stack = Lv2cVerticalStackElement::Create();
+            stack->Style().HorizontalAlignment(Lv2cAlignment::Stretch);
+            for (size_t i = 0; i < FILE_COUNT; ++i)
+            {
+                auto row = Lv2cTypographyElement::Create();
+                row->Variant(Lv2cTypographyVariant::BodyPrimary);
+                row->Text("Recording " + std::to_string(i + 1) + " - take " + std::to_string(i % 7 + 1) + ".wav");
+                row->Style()
+                    .Padding({16, 4, 16, 4})
+                    .HorizontalAlignment(Lv2cAlignment::Stretch);
+                stack->AddChild(row);
+            }
+            scrollContainer->Child(stack);
+            return scrollContainer;
+        }
+        virtual void Update(size_t frame) override
+        {
+            // Scroll down, then back up again.
+            constexpr size_t SCROLL_RANGE = 8000;
+            size_t position = (frame * SCROLL_STEP) % (2 * SCROLL_RANGE);
+            if (position > SCROLL_RANGE)
+            {
+                position = 2 * SCROLL_RANGE - position;
+            }
+            scrollContainer->VerticalScrollOffset((double)position);
+        }
+
+    private:
+        static constexpr size_t FILE_COUNT = 1000;
+        static constexpr size_t SCROLL_STEP = 12;
+        Lv2cScrollContainerElement::ptr scrollContainer;
+    };
+
+    // Text changes every frame, so every frame includes a full layout pass.
+    class TypographyScene : public BenchScene
+    {
+    public:
+        virtual const char *Name() const override { return "typography"; }
+        virtual Lv2cElement::ptr Create(Lv2cTheme::ptr theme) override
+        {
+            auto stack = Lv2cVerticalStackElement::Create();
+            stack->Style()
+                .Background(theme->paper)
+                .Padding({24, 16, 24, 16})
+                .HorizontalAlignment(Lv2cAlignment::Stretch)
+                .VerticalAlignment(Lv2cAlignment::Stretch);
+
+            static const Lv2cTypographyVariant VARIANTS[] = {
+                Lv2cTypographyVariant::Title,
+                Lv2cTypographyVariant::Heading,
+                Lv2cTypographyVariant::Subheading,
+                Lv2cTypographyVariant::BodyPrimary,
+                Lv2cTypographyVariant::BodySecondary,
+                Lv2cTypographyVariant::Caption,
+            };
+            for (size_t i = 0; i < PARAGRAPH_COUNT; ++i)
+            {
+                auto typography = Lv2cTypographyElement::Create();
+                typography->Variant(VARIANTS[i % std::size(VARIANTS)]);
+                typography->Text(ParagraphText(i, 0));
+                typography->Style()
+                    .SingleLine(false)
+                    .Margin({0, 0, 0, 8})
+                    .HorizontalAlignment(Lv2cAlignment::Stretch);
+                paragraphs.push_back(typography);
+                stack->AddChild(typography);
+            }
+            return stack;
+        }
+        virtual void Update(size_t frame) override
+        {
+            size_t i = frame % paragraphs.size();
+            paragraphs[i]->Text(ParagraphText(i, frame));
+        }
+
+    private:
+        static std::string ParagraphText(size_t paragraph, size_t frame)
+        {
+            std::string result = "Paragraph " + std::to_string(paragraph + 1) + " (" + std::to_string(frame) + "). ";
+            for (size_t i = 0; i <= (paragraph + frame) % 4; ++i)
+            {
+                result += "The quick brown fox jumped over the lazy dog. ";
+            }
+            return result;
+        }
+        static constexpr size_t PARAGRAPH_COUNT = 18;
+        std::vector<Lv2cTypographyElement::ptr> paragraphs;
+    };
+
+    // Static cards, with the whole window redrawn every frame.
+    class DropShadowCardsScene : public BenchScene
+    {
+    public:
+        virtual const char *Name() const override { return "drop_shadow_cards"; }
+        virtual Lv2cElement::ptr Create(Lv2cTheme::ptr theme) override
+        {
+            root = CreateGrid(theme);
+            for (size_t i = 0; i < CARD_COUNT; ++i)
+            {
+                auto dropShadow = Lv2cDropShadowElement::Create();
+                dropShadow->Variant(i % 4 == 3 ? Lv2cDropShadowVariant::InnerDropShadow : Lv2cDropShadowVariant::DropShadow)
+                    .Radius(4)
+                    .XOffset(0)
+                    .YOffset(2)
+                    .ShadowOpacity(0.6)
+                    .ShadowColor(Lv2cColor(0, 0, 0));
+                dropShadow->Style()
+                    .Background(theme->dialogBackgroundColor)
+                    .RoundCorners({4})
+                    .Padding({8});
+                {
+                    auto typography = Lv2cTypographyElement::Create();
+                    typography->Variant(Lv2cTypographyVariant::BodySecondary);
+                    typography->Text("Card " + std::to_string(i + 1));
+                    typography->Style().Width(120).Height(60);
+                    dropShadow->AddChild(typography);
+                }
+                root->AddChild(dropShadow);
+            }
+            return root;
+        }
+        virtual void Update(size_t frame) override
+        {
+            root->Invalidate();
+        }
+
+    private:
+        static constexpr size_t CARD_COUNT = 24;
+        Lv2cFlexGridElement::ptr root;
+    };
+
+    // Alternating slide-in/slide-out transitions, plus a continuously varying motion blur.
+    class MotionBlurScene : public BenchScene
+    {
+    public:
+        virtual const char *Name() const override { return "motion_blur"; }
+        virtual Lv2cElement::ptr Create(Lv2cTheme::ptr theme) override
+        {
+            auto grid = CreateGrid(theme);
+            {
+                slide = Lv2cSlideInOutAnimationElement::Create();
+                slide->AddChild(CreateContent(300, 300));
+                grid->AddChild(slide);
+            }
+            {
+                blur = Lv2cMotionBlurElement::Create();
+                blur->Style().Background(theme->background);
+                blur->AddChild(CreateContent(300, 300));
+                grid->AddChild(blur);
+            }
+            return grid;
+        }
+        virtual void Update(size_t frame) override
+        {
+            constexpr size_t TRANSITION_FRAMES = 30;
+            if (frame % TRANSITION_FRAMES == 0)
+            {
+                bool slideIn = (frame / TRANSITION_FRAMES) % 2 == 0;
+                slide->StartAnimation(
+                    slideIn ? Lv2cSlideAnimationType::SlideInStart : Lv2cSlideAnimationType::SlideOutEnd,
+                    250);
+            }
+            double dx = 24 * std::sin(frame * 0.1);
+            blur->Blur(Lv2cPoint(dx, 0), Lv2cPoint(dx * 0.75, 0));
+        }
+
+    private:
+        static Lv2cElement::ptr CreateContent(double width, double height)
+        {
+            auto typography = Lv2cTypographyElement::Create();
+            typography->Text("The quick brown fox jumped over the lazy dog.");
+            typography->Variant(Lv2cTypographyVariant::BodySecondary);
+            typography->Style()
+                .Width(width)
+                .Height(height)
+                .Padding(30)
+                .SingleLine(false)
+                .FontSize(Lv2cMeasurement::Point(22))
+                .Background(Lv2cColor("#000000"));
+            return typography;
+        }
+        Lv2cSlideInOutAnimationElement::ptr slide;
+        Lv2cMotionBlurElement::ptr blur;
+    };
+}
+
+std::vector<BenchScene::ptr> lv2c::bench::CreateBenchScenes()
+{
+    return std::vector<BenchScene::ptr>{
+        std::make_shared<DialGridScene>(),
+        std::make_shared<VuBankScene>(),
+        std::make_shared<FileListScene>(),
+        std::make_shared<TypographyScene>(),
+        std::make_shared<DropShadowCardsScene>(),
+        std::make_shared<MotionBlurScene>(),
+    };
+}
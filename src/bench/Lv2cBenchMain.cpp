@@ -0,0 +1,345 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// lv2c_bench: renders standard UI scenes in a headless window, and reports
+// per-phase frame timings, allocations per frame and peak RSS as JSON.
+//
+// syntax: lv2c_bench [options]
+// options:
+//     --scene [name]     Run only the named scene (default: all scenes).
+//     --frames [n]       Number of measured frames per scene (default 300).
+//     --warmup [n]       Number of unmeasured frames before measuring (default 30).
+//     --width [w]        Window width (default 800).
+//     --height [h]       Window height (default 600).
+//     --scale [s]        Window scale (default 1.0).
+//     --out [filename]   Write JSON results to a file instead of stdout.
+//     --list             List scene names, and exit.
+
+#include "BenchScenes.hpp"
+#include "CommandLineParser.hpp"
+#include "lv2c/Lv2cWindow.hpp"
+#include "lv2c/Lv2cHeadlessWindow.hpp"
+#include "lv2c/JsonStream.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sys/resource.h>
+
+using namespace std;
+using namespace lv2c;
+using namespace lv2c::bench;
+using namespace twoplay;
+
+// Count every allocation made through the global operator new.
+static std::atomic<uint64_t> allocationCount{0};
+
+void *operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    void *p = std::malloc(size == 0 ? 1 : size);
+    if (!p)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+static void SetResourceDirectories(const char *argv0)
+{
+    std::filesystem::path t = argv0;
+    std::filesystem::path executableDirectory = t.parent_path();
+    executableDirectory = std::filesystem::weakly_canonical(executableDirectory);
+
+    std::vector<filesystem::path> resourceDirectories;
+    resourceDirectories.push_back(executableDirectory / "resources");
+
+    resourceDirectories.push_back(executableDirectory);
+    char *env = getenv("RESOURCEDIR");
+    if (env)
+    {
+        resourceDirectories.push_back(env);
+    }
+    Lv2cWindow::SetResourceDirectories(resourceDirectories);
+}
+
+static int64_t PeakRssKb()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return -1;
+    }
+    return usage.ru_maxrss;
+}
+
+struct BenchOptions
+{
+    size_t frames = 300;
+    size_t warmup = 30;
+    double width = 800;
+    double height = 600;
+    double scale = 1.0;
+};
+
+// Per-frame samples for one measured quantity.
+class Samples
+{
+public:
+    void Reserve(size_t n) { values.reserve(n); }
+    void Add(double value) { values.push_back(value); }
+
+    void Write(json_stream_writer &writer)
+    {
+        std::sort(values.begin(), values.end());
+        writer.start_object();
+        writer.member("mean", Mean());
+        writer.member("p50", Percentile(0.50));
+        writer.member("p95", Percentile(0.95));
+        writer.member("max", values.empty() ? 0.0 : values.back());
+        writer.end_object();
+    }
+    double Mean() const
+    {
+        double total = 0;
+        for (double value : values)
+        {
+            total += value;
+        }
+        return values.empty() ? 0.0 : total / values.size();
+    }
+
+private:
+    double Percentile(double p) const
+    {
+        if (values.empty())
+        {
+            return 0;
+        }
+        size_t index = (size_t)std::round(p * (values.size() - 1));
+        return values[index];
+    }
+    std::vector<double> values;
+};
+
+static double Microseconds(std::chrono::nanoseconds time)
+{
+    return time.count() * 0.001;
+}
+
+static void RunScene(BenchScene &scene, const BenchOptions &options, json_stream_writer &writer)
+{
+    auto window = Lv2cWindow::Create();
+    window->WindowScale(options.scale);
+    window->GetRootElement()->AddChild(scene.Create(window->ThemePtr()));
+
+    Lv2cCreateWindowParameters parameters;
+    parameters.size = Lv2cSize(options.width, options.height);
+    parameters.title = scene.Name();
+    Lv2cHeadlessWindow &headless = window->CreateHeadlessWindow(parameters);
+
+    Samples animate, measure, arrange, draw, present, total, allocations;
+    Samples damageRects, elementsMeasured, elementsDrawn, styleLookups, surfacesAllocated;
+    for (Samples *samples : {&animate, &measure, &arrange, &draw, &present, &total, &allocations,
+                             &damageRects, &elementsMeasured, &elementsDrawn, &styleLookups, &surfacesAllocated})
+    {
+        samples->Reserve(options.frames);
+    }
+
+    for (size_t frame = 0; frame < options.warmup + options.frames; ++frame)
+    {
+        scene.Update(frame);
+        headless.AdvanceTime(Lv2cHeadlessWindow::FRAME_INTERVAL);
+
+        uint64_t allocationsStart = allocationCount.load(std::memory_order_relaxed);
+        auto frameStart = std::chrono::steady_clock::now();
+        headless.RenderFrame();
+        auto frameEnd = std::chrono::steady_clock::now();
+        uint64_t allocationsEnd = allocationCount.load(std::memory_order_relaxed);
+
+        if (frame >= options.warmup)
+        {
+            const Lv2cFrameTimings &timings = window->FrameTimings();
+            animate.Add(Microseconds(timings.animate));
+            measure.Add(Microseconds(timings.measure));
+            arrange.Add(Microseconds(timings.arrange));
+            draw.Add(Microseconds(timings.draw));
+            present.Add(Microseconds(timings.present));
+            total.Add(Microseconds(frameEnd - frameStart));
+            allocations.Add((double)(allocationsEnd - allocationsStart));
+
+            const Lv2cFrameCounts &counts = window->FrameCounts();
+            damageRects.Add((double)counts.damageRects);
+            elementsMeasured.Add((double)counts.elementsMeasured);
+            elementsDrawn.Add((double)counts.elementsDrawn);
+            styleLookups.Add((double)counts.styleLookups);
+            surfacesAllocated.Add((double)counts.surfacesAllocated);
+        }
+    }
+    window->Close();
+
+    cerr << setw(20) << left << scene.Name()
+         << right << fixed << setprecision(1)
+         << setw(10) << total.Mean() << "us/frame"
+         << setw(10) << allocations.Mean() << " allocs/frame" << endl;
+
+    writer.start_object();
+    writer.member("name", scene.Name());
+    writer.member("frames", options.frames);
+    writer.key("time_us");
+    writer.start_object();
+    writer.key("animate");
+    animate.Write(writer);
+    writer.key("measure");
+    measure.Write(writer);
+    writer.key("arrange");
+    arrange.Write(writer);
+    writer.key("draw");
+    draw.Write(writer);
+    writer.key("present");
+    present.Write(writer);
+    writer.key("total");
+    total.Write(writer);
+    writer.end_object();
+    writer.key("allocations_per_frame");
+    allocations.Write(writer);
+    writer.key("counts_per_frame");
+    writer.start_object();
+    writer.key("damage_rects");
+    damageRects.Write(writer);
+    writer.key("elements_measured");
+    elementsMeasured.Write(writer);
+    writer.key("elements_drawn");
+    elementsDrawn.Write(writer);
+    writer.key("style_lookups");
+    styleLookups.Write(writer);
+    writer.key("surfaces_allocated");
+    surfacesAllocated.Write(writer);
+    writer.end_object();
+    // ru_maxrss is a high-water mark for the whole process, so this includes earlier scenes.
+    writer.member("peak_rss_kb", PeakRssKb());
+    writer.end_object();
+}
+
+int main(int argc, char **argv)
+{
+    BenchOptions options;
+    std::string sceneName;
+    std::string outputFile;
+    bool listScenes = false;
+
+    CommandLineParser parser;
+    parser.AddOption("--scene", &sceneName);
+    parser.AddOption("--frames", &options.frames);
+    parser.AddOption("--warmup", &options.warmup);
+    parser.AddOption("--width", &options.width);
+    parser.AddOption("--height", &options.height);
+    parser.AddOption("--scale", &options.scale);
+    parser.AddOption("--out", &outputFile);
+    parser.AddOption("--list", &listScenes);
+
+    try
+    {
+        parser.Parse(argc, argv);
+        if (parser.ArgumentCount() != 0)
+        {
+            throw std::runtime_error("Unexpected argument: " + parser.Argument(0));
+        }
+    }
+    catch (const std::exception &e)
+    {
+        cerr << "Error: " << e.what() << endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<BenchScene::ptr> scenes = CreateBenchScenes();
+    if (listScenes)
+    {
+        for (auto &scene : scenes)
+        {
+            cout << scene->Name() << endl;
+        }
+        return EXIT_SUCCESS;
+    }
+    if (sceneName.length() != 0)
+    {
+        auto f = std::find_if(scenes.begin(), scenes.end(), [&sceneName](const BenchScene::ptr &scene)
+                              { return sceneName == scene->Name(); });
+        if (f == scenes.end())
+        {
+            cerr << "Error: No scene named '" << sceneName << "'. Use --list to list scenes." << endl;
+            return EXIT_FAILURE;
+        }
+        scenes = std::vector<BenchScene::ptr>{*f};
+    }
+
+    SetResourceDirectories(argv[0]);
+    try
+    {
+        std::ostream *pOut = &cout;
+        ofstream f;
+        if (outputFile.length() != 0)
+        {
+            f.open(outputFile);
+            if (!f.is_open())
+            {
+                throw std::runtime_error("Unable to open output file.");
+            }
+            pOut = &f;
+        }
+        json_stream_writer writer(*pOut);
+        writer.start_object();
+        writer.member("frames", options.frames);
+        writer.member("warmup", options.warmup);
+        writer.member("width", options.width);
+        writer.member("height", options.height);
+        writer.member("scale", options.scale);
+        writer.key("scenes");
+        writer.start_array();
+        for (auto &scene : scenes)
+        {
+            RunScene(*scene, options, writer);
+        }
+        writer.end_array();
+        writer.member("peak_rss_kb", PeakRssKb());
+        writer.end_object();
+        *pOut << endl;
+    }
+    catch (const std::exception &e)
+    {
+        cerr << "Error: " << e.what() << endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
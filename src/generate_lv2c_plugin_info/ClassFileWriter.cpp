@@ -19,7 +19,11 @@
 
 #include "ClassFileWriter.hpp"
 #include <sstream>
+#include <cmath>
+#include <iomanip>
+#include <set>
 #include "lv2c_ui/Lv2Units.hpp"
+#include "lv2c_ui/Lv2PortTable.hpp"
 
 using namespace std;
 using namespace lv2c::ui;
@@ -204,6 +208,50 @@ std::string CConstant(const Lv2PluginClasses &value)
     return ss.str();
 }
 
+// A float literal that round-trips exactly.
+static std::string FloatLiteral(float value)
+{
+    if (std::isnan(value))
+    {
+        return "std::numeric_limits<float>::quiet_NaN()";
+    }
+    if (std::isinf(value))
+    {
+        return value < 0 ? "-std::numeric_limits<float>::infinity()" : "std::numeric_limits<float>::infinity()";
+    }
+    std::stringstream ss;
+    ss.precision(9);
+    ss << value;
+    std::string result = ss.str();
+    if (result.find_first_of(".e") == std::string::npos)
+    {
+        result += ".0";
+    }
+    return result + "f";
+}
+
+// LV2 symbols are valid C identifiers, but may collide with C++ keywords.
+static std::string EnumIdentifier(const std::string &symbol)
+{
+    static const std::set<std::string> keywords = {
+        "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break",
+        "case", "catch", "char", "char8_t", "char16_t", "char32_t", "class", "compl", "concept",
+        "const", "consteval", "constexpr", "constinit", "const_cast", "continue", "co_await",
+        "co_return", "co_yield", "decltype", "default", "delete", "do", "double", "dynamic_cast",
+        "else", "enum", "explicit", "export", "extern", "false", "float", "for", "friend", "goto",
+        "if", "inline", "int", "long", "mutable", "namespace", "new", "noexcept", "not", "not_eq",
+        "nullptr", "operator", "or", "or_eq", "private", "protected", "public", "register",
+        "reinterpret_cast", "requires", "return", "short", "signed", "sizeof", "static",
+        "static_assert", "static_cast", "struct", "switch", "template", "this", "thread_local",
+        "throw", "true", "try", "typedef", "typeid", "typename", "union", "unsigned", "using",
+        "virtual", "void", "volatile", "wchar_t", "while", "xor", "xor_eq"};
+    if (keywords.contains(symbol))
+    {
+        return symbol + "_";
+    }
+    return symbol;
+}
+
 #define WRITE_PROPERTY(obj, name) \
     s << Tab() << #name << "(" << CConstant(obj->name()) << ");" << endl;
 
@@ -230,7 +278,9 @@ void ClassFileWriter::Write(const std::shared_ptr<Lv2PluginInfo> pluginInfo)
     s << endl;
 
     s << "#include \"lv2c_ui/Lv2PluginInfo.hpp\"" << endl;
+    s << "#include \"lv2c_ui/Lv2PortTable.hpp\"" << endl;
     s << "#include <memory>" << endl;
+    s << "#include <limits>" << endl;
     s << endl;
 
     if (nameSpace.length() != 0)
@@ -249,6 +299,8 @@ void ClassFileWriter::Write(const std::shared_ptr<Lv2PluginInfo> pluginInfo)
             s << Tab() << "static ptr Create() { return std::make_shared<" << className << ">(); }" << endl;
             s << endl;
 
+            WritePortTable(pluginInfo->ports());
+
             s << Tab() << className << "() {" << endl;
             Indent();
             {
@@ -314,6 +366,88 @@ std::string ClassFileWriter::Tab()
     return std::string(indent, ' ');
 }
 
+void ClassFileWriter::WritePortTable(const std::vector<Lv2PortInfo> &ports)
+{
+    s << Tab() << "// Compile-time port metadata. Bind controls with Lv2UI::GetControlProperty(PortIndex)." << endl;
+    s << Tab() << "enum class PortIndex : uint32_t" << endl;
+    s << Tab() << "{" << endl;
+    Indent();
+    for (const auto &port : ports)
+    {
+        s << Tab() << EnumIdentifier(port.symbol()) << " = " << port.index() << "," << endl;
+    }
+    Unindent();
+    s << Tab() << "};" << endl;
+    s << Tab() << "static constexpr uint32_t PORT_COUNT = " << ports.size() << ";" << endl;
+    s << endl;
+
+    for (const auto &port : ports)
+    {
+        if (!port.scale_points().empty())
+        {
+            s << Tab() << "static constexpr lv2c::ui::Lv2ScalePointEntry SCALE_POINTS_" << port.index() << "[] = {";
+            bool first = true;
+            for (const auto &scalePoint : port.scale_points())
+            {
+                if (!first)
+                {
+                    s << ", ";
+                }
+                first = false;
+                s << "{" << FloatLiteral(scalePoint.value()) << ", " << CConstant(scalePoint.label()) << "}";
+            }
+            s << "};" << endl;
+        }
+    }
+
+    if (ports.empty())
+    {
+        s << Tab() << "static constexpr std::span<const lv2c::ui::Lv2PortTableEntry> PortTable() { return {}; }" << endl;
+        s << endl;
+        return;
+    }
+    s << Tab() << "static constexpr lv2c::ui::Lv2PortTableEntry PORT_TABLE[] = {" << endl;
+    Indent();
+    for (const auto &port : ports)
+    {
+        s << Tab() << "{"
+          << port.index()
+          << ", " << CConstant(port.symbol())
+          << ", 0x" << std::hex << lv2c::ui::Lv2SymbolHash(port.symbol()) << std::dec << "ull"
+          << ", " << CConstant(port.name())
+          << ", " << FloatLiteral(port.min_value())
+          << ", " << FloatLiteral(port.max_value())
+          << ", " << FloatLiteral(port.default_value())
+          << ", lv2c::ui::" << CConstant(port.units())
+          << ", " << port.range_steps()
+          << ", " << CConstant(port.is_input())
+          << ", " << CConstant(port.is_output())
+          << ", " << CConstant(port.is_control_port())
+          << ", " << CConstant(port.is_audio_port())
+          << ", " << CConstant(port.is_atom_port())
+          << ", " << CConstant(port.is_logarithmic())
+          << ", " << CConstant(port.integer_property())
+          << ", " << CConstant(port.enumeration_property())
+          << ", " << CConstant(port.toggled_property())
+          << ", " << CConstant(port.trigger())
+          << ", " << CConstant(port.not_on_gui())
+          << ", ";
+        if (port.scale_points().empty())
+        {
+            s << "{}";
+        }
+        else
+        {
+            s << "SCALE_POINTS_" << port.index();
+        }
+        s << "}," << endl;
+    }
+    Unindent();
+    s << Tab() << "};" << endl;
+    s << Tab() << "static constexpr std::span<const lv2c::ui::Lv2PortTableEntry> PortTable() { return PORT_TABLE; }" << endl;
+    s << endl;
+}
+
 void ClassFileWriter::Write(const Lv2PortInfo &port)
 {
     s << Tab() << "Lv2PortInfo_Init {" << endl;
@@ -45,6 +45,7 @@ private:
     void WriteCArray(const std::vector<T> & array, bool addComma);
 
     void Write(const Lv2PortInfo& port);
+    void WritePortTable(const std::vector<Lv2PortInfo> &ports);
     void Indent();
     void Unindent();
     std::string Tab();
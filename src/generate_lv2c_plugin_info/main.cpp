@@ -25,6 +25,14 @@
 #include "ss.hpp"
 #include <memory>
 #include <functional>
+#include <sstream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <iterator>
+#include <filesystem>
+#include <map>
 #include "LilvPluginInfo.hpp"
 #include "ClassFileWriter.hpp"
 
@@ -49,18 +57,9 @@ private:
     std::function<void(void)> fn;
 };
 
-void Process(const std::string &pluginUri, const std::string &extraBundle, const std::string &className, std::string nameSpace,std::ostream &os, bool generateProperties)
+static LilvWorld *CreateWorld(const std::string &extraBundle)
 {
-
     LilvWorld *world = lilv_world_new();
-
-    cleanup t{
-        [world]()
-        {
-            lilv_world_free(world);
-        }
-    };
-
     if (extraBundle.length() != 0)
     {
         AutoLilvNode bundleNode = lilv_new_file_uri(world, nullptr, extraBundle.c_str());
@@ -68,7 +67,11 @@ void Process(const std::string &pluginUri, const std::string &extraBundle, const
     } else {
         lilv_world_load_all(world);
     }
+    return world;
+}
 
+static std::shared_ptr<LilvPluginInfo> LoadPluginInfo(LilvWorld *world, const std::string &pluginUri)
+{
     const LilvPlugins *plugins = lilv_world_get_all_plugins(world);
 
     AutoLilvNode pluginUriNode = lilv_new_uri(world, pluginUri.c_str());
@@ -77,13 +80,197 @@ void Process(const std::string &pluginUri, const std::string &extraBundle, const
     {
         throw std::runtime_error(SS("Plugin not found: " << pluginUri));
     }
-    LilvPluginInfo x(world,plugin);
-    std::shared_ptr<LilvPluginInfo> pluginInfo = std::make_shared<LilvPluginInfo>(world, plugin);
-
-    ClassFileWriter writer(os,className,nameSpace);
+    return std::make_shared<LilvPluginInfo>(world, plugin);
+}
 
+static std::string GenerateClass(std::shared_ptr<LilvPluginInfo> pluginInfo, const std::string &className, std::string nameSpace)
+{
+    std::stringstream s;
+    ClassFileWriter writer(s, className, nameSpace);
     writer.Write(pluginInfo);
+    return s.str();
+}
 
+// Leave unchanged files alone, so that their timestamps don't trigger rebuilds.
+static bool WriteIfChanged(const std::string &path, const std::string &content)
+{
+    {
+        ifstream f(path, std::ios_base::binary);
+        if (f.is_open())
+        {
+            std::string existing{std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>()};
+            if (existing == content)
+            {
+                return false;
+            }
+        }
+    }
+    ofstream f(path, std::ios_base::binary | std::ios_base::trunc);
+    if (!f.is_open())
+    {
+        throw std::runtime_error(SS("Unable to open output file " << path));
+    }
+    f << content;
+    if (!f)
+    {
+        throw std::runtime_error(SS("Failed to write " << path));
+    }
+    return true;
+}
+
+void Process(const std::string &pluginUri, const std::string &extraBundle, const std::string &className, std::string nameSpace, const std::string &outputFile, bool generateProperties)
+{
+    LilvWorld *world = CreateWorld(extraBundle);
+
+    cleanup t{
+        [world]()
+        {
+            lilv_world_free(world);
+        }
+    };
+
+    std::string content = GenerateClass(LoadPluginInfo(world, pluginUri), className, nameSpace);
+    if (outputFile.length() == 0)
+    {
+        cout << content;
+    }
+    else
+    {
+        WriteIfChanged(outputFile, content);
+    }
+}
+
+struct BatchEntry
+{
+    std::string pluginUri;
+    std::string outputFile;
+    std::string className;
+    std::shared_ptr<LilvPluginInfo> pluginInfo;
+    std::string error;
+};
+
+// Manifest format: one plugin per line: "plugin_uri output_file [class_name]". '#' starts a comment.
+static std::vector<BatchEntry> ReadManifest(const std::string &manifestFile, const std::string &defaultClassName)
+{
+    ifstream f(manifestFile);
+    if (!f.is_open())
+    {
+        throw std::runtime_error(SS("Can't open manifest file " << manifestFile));
+    }
+    std::vector<BatchEntry> result;
+    // output paths, normalized so that "a.hpp" and "./a.hpp" match, and the line that first used them.
+    std::map<std::filesystem::path, int> outputLines;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(f, line))
+    {
+        ++lineNumber;
+        auto comment = line.find('#');
+        if (comment != std::string::npos)
+        {
+            line = line.substr(0, comment);
+        }
+        std::stringstream s(line);
+        BatchEntry entry;
+        if (!(s >> entry.pluginUri))
+        {
+            continue; // blank line.
+        }
+        if (!(s >> entry.outputFile))
+        {
+            throw std::runtime_error(SS(manifestFile << "(" << lineNumber << "): Expecting an output file."));
+        }
+        if (!(s >> entry.className))
+        {
+            entry.className = defaultClassName;
+        }
+        // entries are written on parallel threads, so two entries can't share an output file.
+        std::filesystem::path outputPath = std::filesystem::weakly_canonical(std::filesystem::absolute(entry.outputFile));
+        auto inserted = outputLines.insert({outputPath, lineNumber});
+        if (!inserted.second)
+        {
+            throw std::runtime_error(SS(manifestFile << "(" << lineNumber << "): Output file " << entry.outputFile
+                                                     << " is already used on line " << inserted.first->second << "."));
+        }
+        result.push_back(std::move(entry));
+    }
+    return result;
+}
+
+int ProcessBatch(const std::string &manifestFile, const std::string &extraBundle, const std::string &defaultClassName, std::string nameSpace, bool generateProperties)
+{
+    std::vector<BatchEntry> entries = ReadManifest(manifestFile, defaultClassName);
+
+    // Load the world once for all plugins. Lilv isn't thread-safe, so plugin metadata is
+    // read on this thread; code generation and file output run in parallel.
+    {
+        LilvWorld *world = CreateWorld(extraBundle);
+        cleanup t{
+            [world]()
+            {
+                lilv_world_free(world);
+            }
+        };
+        for (auto &entry : entries)
+        {
+            try
+            {
+                entry.pluginInfo = LoadPluginInfo(world, entry.pluginUri);
+            }
+            catch (const std::exception &e)
+            {
+                entry.error = e.what();
+            }
+        }
+    }
+
+    std::atomic<size_t> nextEntry{0};
+    auto worker = [&]()
+    {
+        while (true)
+        {
+            size_t i = nextEntry.fetch_add(1);
+            if (i >= entries.size())
+            {
+                break;
+            }
+            BatchEntry &entry = entries[i];
+            if (!entry.pluginInfo)
+            {
+                continue;
+            }
+            try
+            {
+                WriteIfChanged(entry.outputFile, GenerateClass(entry.pluginInfo, entry.className, nameSpace));
+            }
+            catch (const std::exception &e)
+            {
+                entry.error = e.what();
+            }
+        }
+    };
+    size_t nThreads = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, std::max<size_t>(entries.size(), 1));
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < nThreads; ++i)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    int result = EXIT_SUCCESS;
+    for (const auto &entry : entries)
+    {
+        if (entry.error.length() != 0)
+        {
+            cerr << "Error: " << entry.pluginUri << ": " << entry.error << endl;
+            result = EXIT_FAILURE;
+        }
+    }
+    return result;
 }
 
 int main(int argc, char **argv)
@@ -93,24 +280,27 @@ int main(int argc, char **argv)
     //             --ttl [ttfile]
     //             --class [classname]
     //             --out [filename]
+    //  or:     generate_lv2c_plugin_info --batch [manifest] [options]
 
     std::string ttlFile;
     std::string className = "MyPluginInfo";
     std::string nameSpace;
     bool generateProperties = false;
     std::string outputFile;
+    std::string batchFile;
     CommandLineParser parser;
     parser.AddOption("--ttl", &ttlFile);
     parser.AddOption("--out", &outputFile);
     parser.AddOption("--generate-properties", &generateProperties);
     parser.AddOption("--class", &className);
     parser.AddOption("--namespace", &nameSpace);
+    parser.AddOption("--batch", &batchFile);
 
     try
     {
         parser.Parse(argc, argv);
 
-        if (parser.ArgumentCount() != 1)
+        if (parser.ArgumentCount() != (batchFile.length() != 0 ? 0 : 1))
         {
             throw std::runtime_error("Incorrect number of arguments.");
         }
@@ -120,22 +310,14 @@ int main(int argc, char **argv)
         cerr << "Error: " << e.what() << endl;
         return EXIT_FAILURE;
     }
-    std::string uri = parser.Argument(0);
     try
     {
-        std::ostream *pOut = &cout;
-        ofstream f;
-        if (outputFile.length() != 0)
+        if (batchFile.length() != 0)
         {
-            f.open(outputFile);
-            if (!f.is_open())
-            {
-                throw std::runtime_error("Unable to open output file.");
-            }
-            pOut = &f;
+            return ProcessBatch(batchFile, ttlFile, className, nameSpace, generateProperties);
         }
-
-        Process(uri, ttlFile, className, nameSpace, *pOut, generateProperties);
+        std::string uri = parser.Argument(0);
+        Process(uri, ttlFile, className, nameSpace, outputFile, generateProperties);
     }
     catch (const std::exception &e)
     {
@@ -24,6 +24,20 @@
 
 #include <sstream>
 #include <cmath>
+#include <charconv>
+#include <cstring>
+#include <iterator>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 using namespace lv2c;
 
@@ -32,39 +46,156 @@ static constexpr uint16_t UTF16_SURROGATE_1_BASE = 0xD800U;
 static constexpr uint16_t UTF16_SURROGATE_2_BASE = 0xDC00U;
 static constexpr uint16_t UTF16_SURROGATE_MASK = 0x3FFU;
 
+// Returns a pointer to the first character in [p,end) that is not a space.
+static inline const char *skip_spaces(const char *p, const char *end)
+{
+#if defined(__SSE2__)
+    const __m128i spaces = _mm_set1_epi8(' ');
+    while (end - p >= 16)
+    {
+        __m128i chars = _mm_loadu_si128((const __m128i *)p);
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(chars, spaces)) ^ 0xFFFFU;
+        if (mask != 0)
+        {
+            return p + __builtin_ctz(mask);
+        }
+        p += 16;
+    }
+#elif defined(__ARM_NEON)
+    const uint8x16_t spaces = vdupq_n_u8(' ');
+    while (end - p >= 16)
+    {
+        uint8x16_t chars = vld1q_u8((const uint8_t *)p);
+        if (vminvq_u8(vceqq_u8(chars, spaces)) == 0)
+        {
+            break; // finish with scalar code.
+        }
+        p += 16;
+    }
+#endif
+    while (p != end && *p == ' ')
+    {
+        ++p;
+    }
+    return p;
+}
+
+// Returns a pointer to the first character in [p,end) that is either quoteChar or a '\\'.
+static inline const char *find_string_delimiter(const char *p, const char *end, char quoteChar)
+{
+#if defined(__SSE2__)
+    const __m128i quotes = _mm_set1_epi8(quoteChar);
+    const __m128i escapes = _mm_set1_epi8('\\');
+    while (end - p >= 16)
+    {
+        __m128i chars = _mm_loadu_si128((const __m128i *)p);
+        unsigned mask = (unsigned)_mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(chars, quotes), _mm_cmpeq_epi8(chars, escapes)));
+        if (mask != 0)
+        {
+            return p + __builtin_ctz(mask);
+        }
+        p += 16;
+    }
+#elif defined(__ARM_NEON)
+    const uint8x16_t quotes = vdupq_n_u8((uint8_t)quoteChar);
+    const uint8x16_t escapes = vdupq_n_u8('\\');
+    while (end - p >= 16)
+    {
+        uint8x16_t chars = vld1q_u8((const uint8_t *)p);
+        if (vmaxvq_u8(vorrq_u8(vceqq_u8(chars, quotes), vceqq_u8(chars, escapes))) != 0)
+        {
+            break; // finish with scalar code.
+        }
+        p += 16;
+    }
+#endif
+    while (p != end && *p != quoteChar && *p != '\\')
+    {
+        ++p;
+    }
+    return p;
+}
+
+json_reader::json_reader(std::string_view buffer)
+    : p(buffer.data()), end(buffer.data() + buffer.size())
+{
+}
+
+json_reader::json_reader(std::istream &input)
+    : s(&input)
+{
+    s->exceptions(std::istream::failbit | std::istream::badbit);
+}
+
+json_file_reader::json_file_reader(const std::filesystem::path &path)
+{
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+    {
+        throw json_exception("Can't open file " + path.string());
+    }
+    struct stat statBuf;
+    if (fstat(fd, &statBuf) != 0)
+    {
+        close(fd);
+        throw json_exception("Can't read file " + path.string());
+    }
+    mappedSize = (size_t)statBuf.st_size;
+    if (mappedSize != 0)
+    {
+        void *data = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+        {
+            close(fd);
+            throw json_exception("Can't read file " + path.string());
+        }
+        madvise(data, mappedSize, MADV_SEQUENTIAL);
+        mappedData = data;
+    }
+    close(fd);
+    set_buffer((const char *)mappedData, mappedSize);
+}
+
+json_file_reader::~json_file_reader()
+{
+    if (mappedData != nullptr)
+    {
+        munmap(mappedData, mappedSize);
+    }
+}
+
 void json_reader::skip_whitespace()
 {
-    char c;
     while (true)
     {
-        int ic = s.peek();
+        if (!s)
+        {
+            p = skip_spaces(p, end);
+        }
+        int ic = peek_raw();
         if (ic == -1)
             break;
-        if (is_whitespace((char)ic))
+        char c = (char)ic;
+        if (is_whitespace(c))
         {
-            c = get();
+            get();
         }
-        else if (ic == '/')
+        else if (c == '/')
         {
             get();
-            int c2 = s.peek();
+            int c2 = peek_raw();
             if (c2 == '/')
             {
                 // skip to end of line.
                 get();
-                while (true)
+                while (peek_raw() != -1)
                 {
-                    c2 = s.peek();
-                    if (c2 == '\r' || c2 == '\n')
-                    {
-                        get(); // and continue.
-                        break;
-                    }
-                    if (c2 == -1)
+                    c = get();
+                    if (c == '\r' || c == '\n')
                     {
                         break;
                     }
-                    get();
                 }
             }
             else if (c2 == '*')
@@ -74,7 +205,7 @@ void json_reader::skip_whitespace()
                 while (true)
                 {
                     c = get();
-                    if (c == '*' && s.peek() == '/')
+                    if (c == '*' && peek_raw() == '/')
                     {
                         get();
                         if (--level == 0)
@@ -82,7 +213,7 @@ void json_reader::skip_whitespace()
                             break;
                         }
                     }
-                    if (c == '/' && s.peek() == '*')
+                    if (c == '/' && peek_raw() == '*')
                     {
                         get();
                         ++level;
@@ -115,83 +246,82 @@ std::string json_reader::read_string()
     {
         throw_format_error();
     }
-    std::stringstream s;
+    std::string result;
 
     while (true)
     {
+        if (!s)
+        {
+            // copy unescaped runs in one operation.
+            const char *runEnd = find_string_delimiter(p, end, startingCharacter);
+            result.append(p, runEnd);
+            p = runEnd;
+        }
+
         c = get();
         if (c == startingCharacter)
         {
-            if (s.peek() == startingCharacter) //  "" -> "
-            {
-                get();
-                s.put(c);
-            }
-            else
-            {
-                break;
-            }
+            break;
         }
         if (c != '\\')
         {
-            s << (char)c;
+            result += c;
+            continue;
         }
-        else
+        c = get();
+        switch (c)
         {
-            c = get();
-            switch (c)
-            {
-            case '"':
-            case '\\':
-            default:
-                s << c;
-                break;
-            case 'r':
-                s << '\r';
-                break;
-            case 'b':
-                s << '\b';
-                break;
-            case 'f':
-                s << '\f';
-                break;
-            case 'n':
-                s << '\n';
-                break;
-            case 't':
-                s << '\t';
-                break;
-            case 'u':
+        case '"':
+        case '\\':
+        default:
+            result += c;
+            break;
+        case 'r':
+            result += '\r';
+            break;
+        case 'b':
+            result += '\b';
+            break;
+        case 'f':
+            result += '\f';
+            break;
+        case 'n':
+            result += '\n';
+            break;
+        case 't':
+            result += '\t';
+            break;
+        case 'u':
+        {
+            char16_t uc = read_u_escape();
+            std::u16string s16;
+            if (uc >= UTF16_SURROGATE_1_BASE && uc <= UTF16_SURROGATE_1_BASE + UTF16_SURROGATE_MASK)
             {
-                char16_t uc = read_u_escape();
-                std::basic_stringstream<char16_t> ss16;
-                if (uc >= UTF16_SURROGATE_1_BASE && uc <= UTF16_SURROGATE_1_BASE + UTF16_SURROGATE_MASK)
-                {
-                    // MUST be a UTF16_SURROGATE 2 to be legal.
-                    c = get();
-                    if (c != '\\')
-                        throw_format_error("Invalid UTF16 surrogate pair");
-                    c = get();
-                    if (c != 'u')
-                        throw_format_error("Invalid UTF16 surrogate pair");
-                    char16_t uc2 = read_u_escape();
-                    if (uc2 < UTF16_SURROGATE_2_BASE || uc2 > UTF16_SURROGATE_2_BASE + UTF16_SURROGATE_MASK)
-                    {
-                        throw_format_error("Invalid UTF16 surrogate pair");
-                    }
-                    ss16 << uc << uc2;
-                }
-                else
+                // MUST be a UTF16_SURROGATE 2 to be legal.
+                c = get();
+                if (c != '\\')
+                    throw_format_error("Invalid UTF16 surrogate pair");
+                c = get();
+                if (c != 'u')
+                    throw_format_error("Invalid UTF16 surrogate pair");
+                char16_t uc2 = read_u_escape();
+                if (uc2 < UTF16_SURROGATE_2_BASE || uc2 > UTF16_SURROGATE_2_BASE + UTF16_SURROGATE_MASK)
                 {
-                    ss16 << uc;
+                    throw_format_error("Invalid UTF16 surrogate pair");
                 }
-                s << Utf16ToUtf8(ss16.str());
+                s16 += uc;
+                s16 += uc2;
             }
-            break;
+            else
+            {
+                s16 += uc;
             }
+            result += Utf16ToUtf8(s16);
+        }
+        break;
         }
     }
-    return s.str();
+    return result;
 }
 uint16_t json_reader::read_hex()
 {
@@ -220,23 +350,30 @@ char16_t json_reader::read_u_escape()
 bool json_reader::is_complete()
 {
     skip_whitespace();
-    return s.peek() == -1;
+    return peek_raw() == -1;
 }
 
 void json_reader::consume_token(const char *expectedToken, const char *errorMessage)
 {
     skip_whitespace();
 
-    const char *p = expectedToken;
-    while (*p != '\0')
+    if (s)
     {
-        char expectedChar = *p++;
-        int c = s.get();
-        if (expectedChar != c)
+        for (const char *pToken = expectedToken; *pToken != '\0'; ++pToken)
         {
-            this->throw_format_error(errorMessage);
+            if (s->get() != *pToken)
+            {
+                this->throw_format_error(errorMessage);
+            }
         }
+        return;
     }
+    size_t length = std::strlen(expectedToken);
+    if ((size_t)(end - p) < length || std::memcmp(p, expectedToken, length) != 0)
+    {
+        this->throw_format_error(errorMessage);
+    }
+    p += length;
 }
 
 void json_reader::consume(char expected)
@@ -255,11 +392,10 @@ void json_reader::consume(char expected)
 void json_reader::consume(const char *str)
 {
     skip_whitespace();
-    const char *p = str;
-    while (*p != 0)
+    for (const char *pStr = str; *pStr != 0; ++pStr)
     {
         char c = get();
-        if (c != *p)
+        if (c != *pStr)
         {
             std::stringstream s;
             s << "Expecting '" << str << "'";
@@ -498,16 +634,26 @@ void json_reader::read(double *value)
             return;
         }
     }
-
-    s >> *value;
-    if (s.fail())
+    if (s)
+    {
+        *s >> *value;
+        if (s->fail())
+            throw json_exception("Invalid format.");
+        return;
+    }
+    const char *start = p;
+    if (start != end && *start == '+')
+    {
+        ++start;
+    }
+    auto result = std::from_chars(start, end, *value);
+    if (result.ec != std::errc())
         throw json_exception("Invalid format.");
-}
-
-json_reader::json_reader(std::istream &input)
-    : s(input)
-{
-    s.exceptions(std::istream::failbit | std::istream::badbit);
+    // from_chars accepts "inf", "infinity" and "nan", which istream parsing does not.
+    // An explicit NaN token (above) is the only non-finite value that may be read.
+    if (!std::isfinite(*value))
+        throw json_exception("Invalid format.");
+    p = result.ptr;
 }
 
 void json_reader::read_null()
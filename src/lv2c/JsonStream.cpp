@@ -0,0 +1,309 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "lv2c/JsonStream.hpp"
+
+using namespace lv2c;
+
+json_event_reader::json_event_reader(json_reader &reader)
+    : reader(reader)
+{
+}
+
+json_token json_event_reader::read_value_token()
+{
+    int c = reader.peek();
+    switch (c)
+    {
+    case '{':
+        reader.consume('{');
+        stack.push_back(frame{true});
+        return token_ = json_token::StartObject;
+    case '[':
+        reader.consume('[');
+        stack.push_back(frame{false});
+        return token_ = json_token::StartArray;
+    case '"':
+        stringValue = reader.read_string();
+        return token_ = json_token::String;
+    case 'n':
+        reader.read_null();
+        return token_ = json_token::Null;
+    case 't':
+    case 'f':
+        reader.read(&boolValue);
+        return token_ = json_token::Bool;
+    case -1:
+        throw json_exception("Invalid file format. Unexpected end of file");
+    default:
+        reader.read(&numberValue);
+        return token_ = json_token::Number;
+    }
+}
+
+json_token json_event_reader::next()
+{
+    if (stack.empty())
+    {
+        if (started)
+        {
+            if (!reader.is_complete())
+            {
+                throw json_exception("Invalid file format. Unexpected characters after end of document.");
+            }
+            return token_ = json_token::EndOfInput;
+        }
+        started = true;
+        return read_value_token();
+    }
+    frame &top = stack.back();
+    if (top.is_object)
+    {
+        if (top.after_key)
+        {
+            top.after_key = false;
+            return read_value_token();
+        }
+        if (reader.peek() == '}')
+        {
+            reader.consume('}');
+            stack.pop_back();
+            return token_ = json_token::EndObject;
+        }
+        if (!top.first)
+        {
+            reader.consume(',');
+        }
+        top.first = false;
+        stringValue = reader.read_string();
+        reader.consume(':');
+        top.after_key = true;
+        return token_ = json_token::Key;
+    }
+    else
+    {
+        if (reader.peek() == ']')
+        {
+            reader.consume(']');
+            stack.pop_back();
+            return token_ = json_token::EndArray;
+        }
+        if (!top.first)
+        {
+            reader.consume(',');
+        }
+        top.first = false;
+        return read_value_token();
+    }
+}
+
+void json_event_reader::skip_value()
+{
+    size_t startDepth = stack.size();
+    json_token t = next();
+    if (t == json_token::StartObject || t == json_token::StartArray)
+    {
+        while (stack.size() > startDepth)
+        {
+            next();
+        }
+    }
+    else if (t == json_token::EndObject || t == json_token::EndArray || t == json_token::Key)
+    {
+        throw json_exception("Invalid file format. Expecting a value.");
+    }
+}
+
+json_variant json_event_reader::read_variant()
+{
+    next();
+    return build_variant();
+}
+
+json_variant json_event_reader::build_variant()
+{
+    switch (token_)
+    {
+    case json_token::StartObject:
+    {
+        std::pmr::memory_resource *resource = reader.memory_resource();
+        json_variant result = resource ? json_variant::make_object(resource) : json_variant::make_object();
+        json_object &object = *result.as_object();
+        while (next() == json_token::Key)
+        {
+            std::string key = std::move(stringValue);
+            next();
+            object[key] = build_variant();
+        }
+        return result;
+    }
+    case json_token::StartArray:
+    {
+        std::pmr::memory_resource *resource = reader.memory_resource();
+        json_variant result = resource ? json_variant::make_array(resource) : json_variant::make_array();
+        json_array &array = *result.as_array();
+        while (next() != json_token::EndArray)
+        {
+            array.push_back(build_variant());
+        }
+        return result;
+    }
+    case json_token::String:
+        return json_variant(std::move(stringValue));
+    case json_token::Number:
+        return json_variant(numberValue);
+    case json_token::Bool:
+        return json_variant(boolValue);
+    case json_token::Null:
+        return json_variant();
+    default:
+        throw json_exception("Invalid file format. Expecting a value.");
+    }
+}
+
+///////////////////////////////////
+
+json_stream_writer::json_stream_writer(json_writer &writer)
+    : writer(writer)
+{
+}
+
+json_stream_writer::json_stream_writer(std::ostream &s, bool compressed)
+    : ownedWriter(std::make_unique<json_writer>(s, compressed)),
+      writer(*ownedWriter)
+{
+}
+
+void json_stream_writer::before_value()
+{
+    if (stack.empty())
+    {
+        return;
+    }
+    frame &top = stack.back();
+    if (top.is_object)
+    {
+        if (!after_key)
+        {
+            throw json_exception("Expecting a key.");
+        }
+        after_key = false;
+    }
+    else
+    {
+        if (!top.first)
+        {
+            writer.write_raw(",");
+            writer.endl();
+        }
+        top.first = false;
+    }
+}
+
+void json_stream_writer::key(const std::string &name)
+{
+    if (stack.empty() || !stack.back().is_object || after_key)
+    {
+        throw json_exception("Unexpected key.");
+    }
+    frame &top = stack.back();
+    if (!top.first)
+    {
+        writer.write_raw(",");
+        writer.endl();
+    }
+    top.first = false;
+    writer.check_indent();
+    writer.write(name);
+    writer.write_raw(":");
+    writer.needs_space(true);
+    after_key = true;
+}
+
+void json_stream_writer::start_object()
+{
+    before_value();
+    writer.start_object();
+    stack.push_back(frame{true});
+}
+
+void json_stream_writer::end_object()
+{
+    if (stack.empty() || !stack.back().is_object || after_key)
+    {
+        throw json_exception("Mismatched end_object() call.");
+    }
+    if (!stack.back().first)
+    {
+        writer.endl();
+    }
+    writer.end_object();
+    stack.pop_back();
+}
+
+void json_stream_writer::start_array()
+{
+    before_value();
+    writer.start_array();
+    stack.push_back(frame{false});
+}
+
+void json_stream_writer::end_array()
+{
+    if (stack.empty() || stack.back().is_object)
+    {
+        throw json_exception("Mismatched end_array() call.");
+    }
+    if (!stack.back().first)
+    {
+        writer.endl();
+    }
+    writer.end_array();
+    stack.pop_back();
+}
+
+void json_stream_writer::null_value()
+{
+    before_value();
+    writer.write_null();
+}
+
+void json_stream_writer::value(bool value)
+{
+    before_value();
+    writer.write(value);
+}
+
+void json_stream_writer::value(double value)
+{
+    before_value();
+    writer.write(value);
+}
+
+void json_stream_writer::value(const std::string &value)
+{
+    before_value();
+    writer.write(value);
+}
+
+void json_stream_writer::value(const json_variant &value)
+{
+    before_value();
+    value.write(writer);
+}
@@ -159,52 +159,134 @@ bool json_array::operator==(const json_array &other) const
     return true;
 }
 
+namespace
+{
+    // Borrows the json_reader's scratch vector for the current nesting depth.
+    template <typename T>
+    class scratch_lease
+    {
+    public:
+        scratch_lease(std::deque<std::vector<T>> &scratch, size_t &depth)
+            : depth(depth)
+        {
+            if (scratch.size() <= depth)
+            {
+                scratch.resize(depth + 1); // references to existing deque elements remain valid.
+            }
+            vector = &scratch[depth];
+            vector->clear();
+            ++depth;
+        }
+        ~scratch_lease()
+        {
+            vector->clear();
+            --depth;
+        }
+        std::vector<T> &get() { return *vector; }
+
+    private:
+        std::vector<T> *vector;
+        size_t &depth;
+    };
+}
+
 void json_array::read(json_reader &reader)
 {
     
     reader.consume('[');
     if (reader.peek() != ']')
     {
+        scratch_lease<json_variant> lease(reader.arrayScratch, reader.scratchDepth);
+        std::vector<json_variant> &scratch = lease.get();
         while (true) {
-            json_variant v;
-            v.read(reader);
-            values.push_back(std::move(v));
+            scratch.emplace_back();
+            scratch.back().read(reader);
             if (reader.peek() != ',')
             {
                 break;
             }
             reader.consume(',');
         }
+        values.reserve(values.size() + scratch.size());
+        for (auto &value : scratch)
+        {
+            values.push_back(std::move(value));
+        }
     }
     reader.consume(']');
 }
 
-json_object::iterator json_object::find(const std::string &key)
+/*static*/ uint32_t json_object::hash_key(const std::string &key)
 {
-    for (auto i = begin(); i != end(); ++i)
+    size_t hash = std::hash<std::string>()(key);
+    return (uint32_t)(hash ^ (hash >> 32));
+}
+
+size_t json_object::find_position(const std::string &key) const
+{
+    if (key_index.size() == 0)
+    {
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            if (values[i].first == key)
+            {
+                return i;
+            }
+        }
+        return values.size();
+    }
+    uint32_t hash = hash_key(key);
+    size_t mask = key_index.size() - 1;
+    for (size_t slot = hash & mask;; slot = (slot + 1) & mask)
     {
-        if (i->first == key)
+        const index_entry &entry = key_index[slot];
+        if (entry.position == index_entry::EMPTY)
         {
-            return i;
+            return values.size();
+        }
+        if (entry.hash == hash && values[entry.position].first == key)
+        {
+            return entry.position;
         }
     }
-    return end();
 }
-json_object::const_iterator json_object::find(const std::string &key) const
+
+void json_object::index_insert(uint32_t hash, size_t position)
 {
-    for (auto i = begin(); i != end(); ++i)
+    size_t mask = key_index.size() - 1;
+    size_t slot = hash & mask;
+    while (key_index[slot].position != index_entry::EMPTY)
     {
-        if (i->first == key)
-        {
-            return i;
-        }
+        slot = (slot + 1) & mask;
     }
-    return end();
+    key_index[slot].hash = hash;
+    key_index[slot].position = (uint32_t)position;
 }
 
-bool json_object::operator==(const json_object &other) const
+void json_object::rebuild_index(size_t capacity)
 {
+    key_index.clear();
+    key_index.resize(capacity);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        index_insert(hash_key(values[i].first), i);
+    }
+}
 
+json_object::iterator json_object::find(const std::string &key)
+{
+    return begin() + find_position(key);
+}
+json_object::const_iterator json_object::find(const std::string &key) const
+{
+    return begin() + find_position(key);
+}
+
+bool json_object::operator==(const json_object &other) const
+{
+    // keys are unique, so equal sizes and a match for every member of this is sufficient.
+    if (this->values.size() != other.values.size())
+        return false;
     for (const auto &pair : this->values)
     {
         auto index = other.find(pair.first);
@@ -213,14 +295,6 @@ bool json_object::operator==(const json_object &other) const
         if (!(index->second == pair.second))
             return false;
     }
-    for (const auto &pair : other.values)
-    {
-        auto index = this->find(pair.first);
-        if (index == this->end())
-            return false;
-        if (!(index->second == pair.second))
-            return false;
-    }
     return true;
 }
 
@@ -230,16 +304,17 @@ void json_object::read(json_reader &reader)
 
     if (reader.peek() != '}')
     {
+        scratch_lease<std::pair<std::string, json_variant>> lease(reader.objectScratch, reader.scratchDepth);
+        auto &scratch = lease.get();
 
         while (true)
         {
-            std::string key;
-            json_variant value;
-            reader.read(&key);
+            scratch.emplace_back();
+            auto &member = scratch.back();
+            reader.read(&member.first);
             reader.consume(':');
-            value.read(reader);
+            member.second.read(reader);
 
-            (*this)[key] = value;
             if (reader.peek() == ',')
             {
                 reader.consume(',');
@@ -247,6 +322,19 @@ void json_object::read(json_reader &reader)
                 break;
             }
         }
+        values.reserve(values.size() + scratch.size());
+        for (auto &member : scratch)
+        {
+            size_t position = find_position(member.first);
+            if (position != values.size())
+            {
+                values[position].second = std::move(member.second);
+            }
+            else
+            {
+                append(std::move(member.first)) = std::move(member.second);
+            }
+        }
     }
 
     reader.end_object();
@@ -276,40 +364,60 @@ size_t json_variant::size() const
 
 json_variant &json_object::at(const std::string &index)
 {
-    for (auto &entry : values)
+    size_t position = find_position(index);
+    if (position == values.size())
     {
-        if (entry.first == index)
-        {
-            return entry.second;
-        }
+        throw std::runtime_error("Not found.");
     }
-    throw std::runtime_error("Not found.");
-    values.push_back(std::pair(index, json_variant()));
-    return values[values.size() - 1].second;
+    return values[position].second;
 }
 const json_variant &json_object::at(const std::string &index) const
 {
-    for (const auto &entry : values)
+    size_t position = find_position(index);
+    if (position == values.size())
     {
-        if (entry.first == index)
-        {
-            return entry.second;
-        }
+        throw std::runtime_error("Not found.");
     }
-    throw std::runtime_error("Not found.");
+    return values[position].second;
 }
 
 json_variant &json_object::operator[](const std::string &index)
 {
-    for (auto &entry : values)
+    size_t position = find_position(index);
+    if (position != values.size())
     {
-        if (entry.first == index)
+        return values[position].second;
+    }
+    return append(std::string(index));
+}
+
+json_variant &json_object::append(std::string &&key)
+{
+    size_t position = values.size();
+    values.push_back(std::pair<std::string, json_variant>(std::move(key), json_variant()));
+
+    if (key_index.size() != 0)
+    {
+        // keep load factor <= 0.5.
+        if (values.size() * 2 > key_index.size())
+        {
+            rebuild_index(key_index.size() * 2);
+        }
+        else
+        {
+            index_insert(hash_key(values[position].first), position);
+        }
+    }
+    else if (values.size() >= INDEX_THRESHOLD)
+    {
+        size_t capacity = 1;
+        while (capacity < values.size() * 2)
         {
-            return entry.second;
+            capacity *= 2;
         }
+        rebuild_index(capacity);
     }
-    values.push_back(std::pair<std::string, json_variant>(index, json_variant()));
-    return values[values.size() - 1].second;
+    return values[position].second;
 }
 const json_variant &json_object::operator[](const std::string &index) const
 {
@@ -439,8 +547,11 @@ json_array::json_array(json_array &&other)
     ++allocation_count_;
 }
 json_object::json_object(json_object &&other)
-    : values(std::move(other.values))
+    : values(std::move(other.values)),
+      key_index(std::move(other.key_index))
 {
+    other.values.clear();
+    other.key_index.clear();
     ++allocation_count_;
 }
 
@@ -464,15 +575,15 @@ void json_variant::read(json_reader &reader)
     int v = reader.peek();
     if (v == '[')
     {
-        json_array array;
-        array.read(reader);
-        (*this) = std::move(array);
+        std::pmr::memory_resource *resource = reader.memory_resource();
+        (*this) = resource ? make_array(resource) : make_array();
+        memArray()->read(reader);
     }
     else if (v == '{')
     {
-        json_object object;
-        object.read(reader);
-        (*this) = std::move(object);
+        std::pmr::memory_resource *resource = reader.memory_resource();
+        (*this) = resource ? make_object(resource) : make_object();
+        memObject()->read(reader);
     }
     else if (v == '\"')
     {
@@ -96,7 +96,7 @@ void Lv2cAnimator::StartAnimation()
     {
         if (ownerMounted)
         {
-            this->lastAnimationTime = clock_t::now();
+            this->lastAnimationTime = owner->Window()->Now();
             animationHandle = owner->Window()->RequestAnimationCallback(
                 [this](clock_t::time_point now)
                 { AnimationTick(now); });
@@ -265,7 +265,7 @@ void Lv2cButtonBaseElement::StartAnimation(bool increasing)
         return;
     }
     this->animationStartValue = this->animationValue;
-    this->animationStartTime = clock_t::now();
+    this->animationStartTime = Window()->Now();
     this->animationIncreasing = increasing;
     RequestAnimationTick();
 }
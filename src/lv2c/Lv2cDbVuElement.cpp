@@ -3,10 +3,6 @@
 
 using namespace lv2c;
 
-using namespace std::chrono;
-constexpr milliseconds HOLD_TIME = 2000ms;
-
-
 
 void Lv2cDbVuElement::UpdateStyle()
 {
@@ -175,21 +171,44 @@ void Lv2cStereoDbVuElement::OnDraw(Lv2cDrawingContext &dc)
 
 Lv2cDbVuElement::Lv2cDbVuElement()
 {
-    HoldValueProperty.SetElement(this, Lv2cBindingFlags::InvalidateOnChanged);
+    // Hold value changes are invalidated by OnMeterHoldChanged, one strip at a time.
+    HoldValueProperty.SetElement(this, Lv2cBindingFlags::Empty);
+
+    minValueObserverHandle = MinValueProperty.addObserver([this](double) { UpdateMeterRange(); });
+    maxValueObserverHandle = MaxValueProperty.addObserver([this](double) { UpdateMeterRange(); });
 }
 Lv2cStereoDbVuElement::Lv2cStereoDbVuElement()
 {
-    leftAnimationStartTime = rightAnimationStartTime = clock_t::now();
+    HoldValueProperty.SetElement(this, Lv2cBindingFlags::Empty);
+    RightHoldValueProperty.SetElement(this, Lv2cBindingFlags::Empty);
 
-    HoldValueProperty.SetElement(this, Lv2cBindingFlags::InvalidateOnChanged);
-    RightHoldValueProperty.SetElement(this, Lv2cBindingFlags::InvalidateOnChanged);
+    minValueObserverHandle = MinValueProperty.addObserver([this](double) { UpdateMeterRange(); });
+    maxValueObserverHandle = MaxValueProperty.addObserver([this](double) { UpdateMeterRange(); });
+}
+
+void Lv2cDbVuElement::UpdateMeterRange()
+{
+    if (meterChannel != Lv2cMeterBallistics::INVALID_CHANNEL)
+    {
+        Window()->MeterBallistics().Range(meterChannel, MaxValue() - MinValue());
+    }
+}
+void Lv2cStereoDbVuElement::UpdateMeterRange()
+{
+    if (leftMeterChannel != Lv2cMeterBallistics::INVALID_CHANNEL)
+    {
+        auto &ballistics = Window()->MeterBallistics();
+        double range = MaxValue() - MinValue();
+        ballistics.Range(leftMeterChannel, range);
+        ballistics.Range(rightMeterChannel, range);
+    }
 }
 
 void Lv2cDbVuElement::OnMount()
 {
     super::OnMount();
     HoldValue(Value());
-    StopAnimation();
+    meterChannel = Window()->MeterBallistics().AddChannel(this, 0, Value(), MaxValue() - MinValue());
 }
 
 void Lv2cStereoDbVuElement::OnMount()
@@ -197,251 +216,95 @@ void Lv2cStereoDbVuElement::OnMount()
     super::OnMount();
     HoldValue(Value());
     RightHoldValue(RightValue());
-    StopAnimation();
+    auto &ballistics = Window()->MeterBallistics();
+    double range = MaxValue() - MinValue();
+    leftMeterChannel = ballistics.AddChannel(this, 0, Value(), range);
+    rightMeterChannel = ballistics.AddChannel(this, 1, RightValue(), range);
 }
 
 void Lv2cDbVuElement::OnUnmount()
 {
-    StopAnimation();
-}
-void Lv2cStereoDbVuElement::OnUnmount()
-{
-    StopAnimation();
-}
-void Lv2cDbVuElement::OnValueChanged(double value)
-{
-    super::OnValueChanged(value);
-    if (IsMounted())
+    if (meterChannel != Lv2cMeterBallistics::INVALID_CHANNEL)
     {
-        if (value > HoldValue())
-        {
-            HoldValue(value);
-            StartAnimation(true);
-        } else {
-            StartAnimation(false);
-        }
-    } else {
-        HoldValue(value);
+        Window()->MeterBallistics().RemoveChannel(meterChannel);
+        meterChannel = Lv2cMeterBallistics::INVALID_CHANNEL;
     }
 }
-void Lv2cStereoDbVuElement::OnValueChanged(double value)
+void Lv2cStereoDbVuElement::OnUnmount()
 {
-    super::OnValueChanged(value);
-    if (IsMounted())
+    if (leftMeterChannel != Lv2cMeterBallistics::INVALID_CHANNEL)
     {
-        if (value > HoldValue())
-        {
-            HoldValue(value);
-            StartLeftAnimation(true);
-        } else {
-            StartLeftAnimation(false);
-        }
-    } else {
-        HoldValue(value);        
+        auto &ballistics = Window()->MeterBallistics();
+        ballistics.RemoveChannel(leftMeterChannel);
+        ballistics.RemoveChannel(rightMeterChannel);
+        leftMeterChannel = rightMeterChannel = Lv2cMeterBallistics::INVALID_CHANNEL;
     }
 }
-void Lv2cStereoDbVuElement::OnRightValueChanged(double value)
-{
-    super::OnValueChanged(value);
-    if (IsMounted())
-    {
-        if (value > RightHoldValue())
-        {
-            RightHoldValue(value);
-            StartRightAnimation(true);
-        } else {
-            if (rightAnimationActive)
-            {
-                return;
-            }
-            StartRightAnimation(false);
-        }
-    } else {
-        RightHoldValue(value);
-    }
-}
-
 
-void Lv2cDbVuElement::StopAnimation()
+void Lv2cDbVuElement::OnValueChanged(double value)
 {
-    if (animationHandle)
+    super::OnValueChanged(value); // invalidates the bar.
+    if (meterChannel == Lv2cMeterBallistics::INVALID_CHANNEL)
     {
-        this->Window()->CancelAnimationCallback(animationHandle);
-        animationHandle = AnimationHandle::InvalidHandle;
+        HoldValue(value);
+        return;
     }
+    double oldHold = HoldValue();
+    double hold = Window()->MeterBallistics().Level(meterChannel, value);
+    HoldValue(hold);
+    InvalidateValueChange(oldHold, hold);
 }
-void Lv2cStereoDbVuElement::StopAnimation()
+
+void Lv2cDbVuElement::OnMeterHoldChanged(size_t clientChannel, double holdValue)
 {
-    if (animationHandle)
-    {
-        this->Window()->CancelAnimationCallback(animationHandle);
-        animationHandle = AnimationHandle::InvalidHandle;
-    }
-    rightAnimationActive = false;
-    leftAnimationActive = false;
+    double oldHold = HoldValue();
+    HoldValue(holdValue);
+    InvalidateValueChange(oldHold, holdValue);
 }
 
-void Lv2cDbVuElement::AnimationTick(const animation_clock_time_point_t&now)
+void Lv2cStereoDbVuElement::OnValueChanged(double value)
 {
-    animationHandle = AnimationHandle::InvalidHandle;
-    constexpr double HOLD_RATE = 1.0; // full exursion in seconds.
-    using namespace std::chrono;
-    constexpr clock_t::rep TICKS_PER_SECOND = duration_cast<clock_t::duration>(1000ms).count();
-    constexpr double TICKS_TO_SECONDS = 1.0 / TICKS_PER_SECOND;
-
-    double seconds = (now - animationStartTime).count() * TICKS_TO_SECONDS;
-    if (seconds > 0)
+    super::OnValueChanged(value); // invalidates the bar.
+    if (leftMeterChannel == Lv2cMeterBallistics::INVALID_CHANNEL)
     {
-        double decayTime = seconds;
-        double newValue = animationStartValue - decayTime / HOLD_RATE * (MaxValue() - MinValue());
-        if (newValue < Value())
-        {
-            HoldValue(Value());
-            animationHandle = AnimationHandle::InvalidHandle;
-            return; // all done, no more animation.
-        }
-        HoldValue(newValue);
-    }
-    if (Window())
-    {
-        animationHandle = Window()->RequestAnimationCallback(
-            [this](const animation_clock_time_point_t&now)
-            {
-                AnimationTick(now);
-            });
+        HoldValue(value);
+        return;
     }
+    double oldHold = HoldValue();
+    double hold = Window()->MeterBallistics().Level(leftMeterChannel, value);
+    HoldValue(hold);
+    InvalidateValueChange(oldHold, hold);
 }
-void Lv2cStereoDbVuElement::AnimationTick(const animation_clock_time_point_t&now)
+void Lv2cStereoDbVuElement::OnRightValueChanged(double value)
 {
-    using namespace std::chrono;
-
-    animationHandle = AnimationHandle::InvalidHandle;
-    constexpr double HOLD_RATE = 1.0; // full exursion in seconds.
-    constexpr clock_t::rep TICKS_PER_SECOND = duration_cast<clock_t::duration>(1000ms).count();
-    constexpr double TICKS_TO_SECONDS = 1.0 / TICKS_PER_SECOND;
-
-    bool animated = false;
+    super::OnRightValueChanged(value); // invalidates the bar.
+    if (rightMeterChannel == Lv2cMeterBallistics::INVALID_CHANNEL)
     {
-        if (leftAnimationActive)
-        {
-            double seconds = (now - leftAnimationStartTime).count() * TICKS_TO_SECONDS;
-            if (seconds <= 0)
-            {
-                animated = true;
-            }
-            else 
-            {
-                double decayTime = seconds;
-                double newValue = leftAnimationStartValue - decayTime / HOLD_RATE * (MaxValue() - MinValue());
-                if (newValue < Value())
-                {
-                    HoldValue(Value());
-                    leftAnimationActive = false;
-                } else {
-                    animated = true;
-                    HoldValue(newValue);
-                }
-            }
-        }
-    }
-    {
-        if (rightAnimationActive)
-        {
-            double seconds = (now - rightAnimationStartTime).count() * TICKS_TO_SECONDS;
-            if (seconds <= 0)
-            {
-                animated = true;
-            } else 
-            {
-                double decayTime = seconds;
-                double newValue = rightAnimationStartValue - decayTime / HOLD_RATE * (MaxValue() - MinValue());
-                if (newValue < RightValue())
-                {
-                    rightAnimationActive = false;
-                    RightHoldValue(RightValue());
-                } else {
-                    animated = true;
-                    RightHoldValue(newValue);
-                }
-            }
-        }
+        RightHoldValue(value);
+        return;
     }
-
-    if (animated && Window())
+    double oldHold = RightHoldValue();
+    double hold = Window()->MeterBallistics().Level(rightMeterChannel, value);
+    RightHoldValue(hold);
+    if (hold != oldHold)
     {
-        animationHandle = Window()->RequestAnimationCallback(
-            [this](const animation_clock_time_point_t&now)
-            {
-                AnimationTick(now);
-            });
-    } else {
-        animationHandle = AnimationHandle::InvalidHandle;
+        InvalidateClientRect(RightValueDirtyRect(oldHold, hold));
     }
 }
 
-void Lv2cDbVuElement::StartAnimation(bool hold)
+void Lv2cStereoDbVuElement::OnMeterHoldChanged(size_t clientChannel, double holdValue)
 {
-    using namespace std::chrono;
-    if (hold) {
-        animationStartTime = clock_t::now() + duration_cast<clock_t::duration>(HOLD_TIME);
-    } else {
-        if (animationHandle) 
-        {
-            return;
-        }
-        animationStartTime = clock_t::now();
-    }
-    animationStartValue = HoldValue();
-    if (!animationHandle)
+    if (clientChannel == 0)
     {
-        this->Window()->RequestAnimationCallback(
-            [this](const animation_clock_time_point_t&now)
-            {
-                AnimationTick(now);
-            });
+        double oldHold = HoldValue();
+        HoldValue(holdValue);
+        InvalidateValueChange(oldHold, holdValue);
     }
-}
-void Lv2cStereoDbVuElement::StartLeftAnimation(bool hold)
-{
-    using namespace std::chrono;
-    if (hold) {
-        leftAnimationStartTime = clock_t::now() + duration_cast<clock_t::duration>(HOLD_TIME);
-    } else {
-        if (leftAnimationActive) 
-        {
-            return;
-        }
-        leftAnimationStartTime = clock_t::now();
-    }
-    leftAnimationStartValue = HoldValue();
-    leftAnimationActive = true;
-    if (!animationHandle)
-    {
-        this->Window()->RequestAnimationCallback(
-            [this](const animation_clock_time_point_t&now)
-            {
-                AnimationTick(now);
-            });
-    }
-}
-
-void Lv2cStereoDbVuElement::StartRightAnimation(bool hold)
-{
-    using namespace std::chrono;
-    if (hold) {
-        rightAnimationStartTime = clock_t::now() + duration_cast<clock_t::duration>(HOLD_TIME);
-    } else {
-        rightAnimationStartTime = clock_t::now();
-    }
-    rightAnimationStartValue = RightHoldValue();
-    rightAnimationActive = true;
-    if (!animationHandle)
+    else
     {
-        this->Window()->RequestAnimationCallback(
-            [this](const animation_clock_time_point_t&now)
-            {
-                AnimationTick(now);
-            });
+        double oldHold = RightHoldValue();
+        RightHoldValue(holdValue);
+        InvalidateClientRect(RightValueDirtyRect(oldHold, holdValue));
     }
 }
 
@@ -19,9 +19,20 @@
 
 #include "lv2c/Lv2cDialElement.hpp"
 #include "lv2c/Lv2cWindow.hpp"
+#include <cmath>
+#include <numbers>
 
 using namespace lv2c;
 
+// The built-in dial image, and the half-width of its indicator as a fraction of the dial radius.
+static constexpr const char *DEFAULT_DIAL_SOURCE = "fx_dial.svg";
+static constexpr double DEFAULT_DIAL_INDICATOR_WIDTH = 0.35;
+
+static double ValueToAngle(double value)
+{
+    return (value - 0.5) * (2*135);
+}
+
 Lv2cDialElement::Lv2cDialElement()
 {
     
@@ -33,6 +44,8 @@ Lv2cDialElement::Lv2cDialElement()
         .HorizontalAlignment(Lv2cAlignment::Stretch)
         .VerticalAlignment(Lv2cAlignment::Stretch)
         ;
+    // Value changes invalidate ValueDirtyRect() instead.
+    this->image->InvalidateOnRotation(false);
 
     SourceProperty.Bind(image->SourceProperty);
 
@@ -54,9 +67,57 @@ void Lv2cDialElement::OnMount()
 }
 void Lv2cDialElement::OnValueChanged(double value)
 {
+    this->image->Rotation(ValueToAngle(value));
+    InvalidateValueChange(displayedValue, value);
+    displayedValue = value;
+}
+
+Lv2cRectangle Lv2cDialElement::ValueDirtyRect(double oldValue, double newValue)
+{
+    double indicatorWidth = IndicatorWidth();
+    if (indicatorWidth == 0 && Source() == DEFAULT_DIAL_SOURCE)
+    {
+        indicatorWidth = DEFAULT_DIAL_INDICATOR_WIDTH;
+    }
+    if (indicatorWidth <= 0)
+    {
+        return ClientRectangle();
+    }
+    const Lv2cRectangle &imageBounds = image->ScreenClientBounds();
+    const Lv2cRectangle &clientBounds = ScreenClientBounds();
+    double cx = imageBounds.Left() - clientBounds.Left() + imageBounds.Width() / 2;
+    double cy = imageBounds.Top() - clientBounds.Top() + imageBounds.Height() / 2;
+    double radius = std::min(imageBounds.Width(), imageBounds.Height()) / 2;
 
-    double angle = (this->Value() - 0.5) * (2*135);
-    this->image->Rotation(angle);
+    // The indicator at zero rotation: from just below the center to the top of the dial.
+    const Lv2cPoint corners[4] = {
+        {-indicatorWidth * radius, -radius},
+        {indicatorWidth * radius, -radius},
+        {-indicatorWidth * radius, 0.1 * radius},
+        {indicatorWidth * radius, 0.1 * radius}};
+
+    Lv2cRectangle result;
+    for (double angle : {ValueToAngle(oldValue), ValueToAngle(newValue)})
+    {
+        double radians = angle * std::numbers::pi / 180.0;
+        double sinA = std::sin(radians);
+        double cosA = std::cos(radians);
+        double left = cx, top = cy, right = cx, bottom = cy;
+        for (const Lv2cPoint &corner : corners)
+        {
+            double x = cx + corner.x * cosA - corner.y * sinA;
+            double y = cy + corner.x * sinA + corner.y * cosA;
+            left = std::min(left, x);
+            right = std::max(right, x);
+            top = std::min(top, y);
+            bottom = std::max(bottom, y);
+        }
+        result = result.Union(Lv2cRectangle(left, top, right - left, bottom - top));
+    }
+    // antialiasing, and the shadow cast by the indicator.
+    double shadowX = dropShadow->Radius() + std::abs(dropShadow->XOffset()) + 1;
+    double shadowY = dropShadow->Radius() + std::abs(dropShadow->YOffset()) + 1;
+    return result.Inflate(shadowX, shadowY, shadowX, shadowY);
 }
 
 void Lv2cDialElement::OnDialOpacityChanged(double opacity) 
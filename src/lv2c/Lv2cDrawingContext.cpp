@@ -19,6 +19,7 @@
 
 #include "lv2c/Lv2cDrawingContext.hpp"
 #include "lv2c/Lv2cLog.hpp"
+#include "lv2c/Lv2cInstrumentation.hpp"
 #include "cairo/cairo.h"
 #include <numbers>
 #include "ss.hpp"
@@ -355,6 +356,7 @@ Lv2cImageSurface::Lv2cImageSurface(
     int height)
 {
     surface = cairo_image_surface_create(format, width, height);
+    ++gWorkCounters.surfacesAllocated;
     check_status();
 }
 
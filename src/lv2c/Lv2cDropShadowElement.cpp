@@ -23,6 +23,7 @@
 #include <memory.h>
 #include <numbers>
 #include "lv2c/Lv2cWindow.hpp"
+#include "lv2c/Lv2cSurfacePool.hpp"
 
 using namespace lv2c;
 
@@ -493,17 +494,11 @@ void Lv2cDropShadowElement::DrawDropShadow(Lv2cDrawingContext &dc, const Lv2cRec
 
     double windowScale = Window()->WindowScale();
 
-    cairo_surface_t *renderSurface = cairo_image_surface_create(
+    Lv2cImageSurface renderSurface = Window()->SurfacePool().Acquire(
         cairo_format_t::CAIRO_FORMAT_A8,
         (int)std::round(deviceBufferBounds.Width()),
         (int)std::round(deviceBufferBounds.Height()));
 
-    cleanup renderSurfaceX{
-        [renderSurface]()
-        {
-            cairo_surface_destroy(renderSurface);
-        }};
-
     {
         Lv2cDrawingContext bdc(renderSurface);
 
@@ -513,11 +508,11 @@ void Lv2cDropShadowElement::DrawDropShadow(Lv2cDrawingContext &dc, const Lv2cRec
         super::DrawPostOpacity(bdc, userBufferBounds);
         bdc.restore();
     }
-    cairo_surface_flush(renderSurface);
+    renderSurface.flush();
     double xOffset, yOffset;
-    BlurDropShadow(dc, renderSurface, &xOffset, &yOffset);
+    BlurDropShadow(dc, renderSurface.get(), &xOffset, &yOffset);
 
-    cairo_surface_mark_dirty(renderSurface);
+    renderSurface.mark_dirty();
     dc.save();
     {
         dc.set_source(Lv2cColor(ShadowColor(), ShadowOpacity()));
@@ -557,10 +552,9 @@ void Lv2cDropShadowElement::DrawInsetDropShadow(Lv2cDrawingContext &dc, const Lv
     Lv2cRectangle userBufferBounds = dc.device_to_user(deviceBufferBounds);
     Lv2cRectangle userDisplayBounds = dc.device_to_user(deviceDisplayBounds);
 
-    Lv2cImageSurface colorSurface {
+    Lv2cImageSurface colorSurface = Window()->SurfacePool().Acquire(
         cairo_format_t::CAIRO_FORMAT_ARGB32,
-        (int)deviceBufferBounds.Width(), (int)deviceBufferBounds.Height()
-    };
+        (int)deviceBufferBounds.Width(), (int)deviceBufferBounds.Height());
     // Render into the working buffer.
     Lv2cDrawingContext cdc(colorSurface);
     {
@@ -573,10 +567,10 @@ void Lv2cDropShadowElement::DrawInsetDropShadow(Lv2cDrawingContext &dc, const Lv
     }
     colorSurface.flush();
 
-    Lv2cImageSurface alphaSurface { 
+    // Every pixel is overwritten with the SOURCE operator below.
+    Lv2cImageSurface alphaSurface = Window()->SurfacePool().Acquire(
         cairo_format_t::CAIRO_FORMAT_A8,
-        colorSurface.get_width(), colorSurface.get_height()
-        };
+        colorSurface.get_width(), colorSurface.get_height(), false);
     {
         Lv2cDrawingContext alphaDc(alphaSurface);
         alphaDc.set_operator(cairo_operator_t::CAIRO_OPERATOR_SOURCE);
@@ -20,8 +20,10 @@
 #include "lv2c/Lv2cElement.hpp"
 #include "lv2c/Lv2cLog.hpp"
 #include "lv2c/Lv2cWindow.hpp"
+#include "lv2c/Lv2cSurfacePool.hpp"
 #include "lv2c/Lv2cTypes.hpp"
 #include "lv2c/Lv2cContainerElement.hpp"
+#include "lv2c/Lv2cInstrumentation.hpp"
 #include <stdexcept>
 #include <iostream>
 #include <numbers>
@@ -264,7 +266,7 @@ void Lv2cElement::Draw(Lv2cDrawingContext &dc, const Lv2cRectangle &clipBounds)
 
         Lv2cRectangle screenBounds = dc.device_to_user(deviceBounds);
 
-        cairo_surface_t *renderSurface = cairo_image_surface_create(
+        Lv2cImageSurface renderSurface = Window()->SurfacePool().Acquire(
             cairo_format_t::CAIRO_FORMAT_ARGB32,
             (int)std::round(deviceBounds.Width()),
             (int)std::round(deviceBounds.Height()));
@@ -293,8 +295,6 @@ void Lv2cElement::Draw(Lv2cDrawingContext &dc, const Lv2cRectangle &clipBounds)
         }
         dc.restore();
 
-        cairo_surface_destroy(renderSurface);
-
         dc.check_status();
     }
     else
@@ -335,6 +335,7 @@ void Lv2cElement::DrawPostOpacity(Lv2cDrawingContext &dc, const Lv2cRectangle &c
             dc.clip();
             dc.translate(screenClientBounds.Left(), screenClientBounds.Top());
 
+            ++gWorkCounters.elementsDrawn;
             OnDraw(dc);
             dc.restore();
         }
@@ -484,6 +485,7 @@ Lv2cRectangle Lv2cElement::removeThickness(const Lv2cRectangle &rectangle, const
 
 void Lv2cElement::SetMeasure(Lv2cSize measuredSize)
 {
+    ++gWorkCounters.elementsMeasured;
     this->measure = measuredSize;
 }
 Lv2cSize Lv2cElement::MeasuredSize() const
@@ -1136,6 +1138,11 @@ bool Lv2cElement::WantsFocus() const
     return false;
 }
 
+bool Lv2cElement::WantsAllMouseMotion() const
+{
+    return false;
+}
+
 const Lv2cRectangle &Lv2cElement::ScreenBounds() const
 {
     return this->screenBounds;
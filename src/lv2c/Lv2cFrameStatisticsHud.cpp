@@ -0,0 +1,125 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "Lv2cFrameStatisticsHud.hpp"
+#include "lv2c/Lv2cDrawingContext.hpp"
+#include "pango/pangocairo.h"
+#include "ss.hpp"
+#include <algorithm>
+#include <iomanip>
+
+using namespace lv2c;
+
+static constexpr double HUD_WIDTH = 280;
+static constexpr double HUD_MARGIN = 8;
+static constexpr double HUD_PADDING = 6;
+static constexpr double TEXT_HEIGHT = 64;
+static constexpr double GRAPH_HEIGHT = 32;
+/// Frame time at the top of the graph.
+static constexpr double GRAPH_MAX_MS = 1000.0 / 30;
+static constexpr double TARGET_FRAME_MS = 1000.0 / 60;
+
+static double Milliseconds(std::chrono::nanoseconds duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+Lv2cFrameStatisticsHud::Lv2cFrameStatisticsHud()
+    : bounds(
+          HUD_MARGIN, HUD_MARGIN,
+          HUD_WIDTH, HUD_PADDING * 3 + TEXT_HEIGHT + GRAPH_HEIGHT),
+      frameTimesMs(HISTORY_SIZE, 0.0)
+{
+}
+
+Lv2cFrameStatisticsHud::~Lv2cFrameStatisticsHud()
+{
+    if (layout)
+    {
+        g_object_unref(layout);
+        layout = nullptr;
+    }
+}
+
+void Lv2cFrameStatisticsHud::AddFrame(const Lv2cFrameRecord &frame)
+{
+    lastFrame = frame;
+    frameTimesMs[historyHead] = Milliseconds(frame.end - frame.start);
+    historyHead = (historyHead + 1) % HISTORY_SIZE;
+}
+
+void Lv2cFrameStatisticsHud::Draw(Lv2cDrawingContext &dc, PangoContext *pangoContext)
+{
+    if (!layout)
+    {
+        layout = pango_layout_new(pangoContext);
+        PangoFontDescription *fontDescription = pango_font_description_from_string("Monospace 8");
+        pango_layout_set_font_description(layout, fontDescription);
+        pango_font_description_free(fontDescription);
+    }
+    const Lv2cFrameTimings &timings = lastFrame.timings;
+    const Lv2cFrameCounts &counts = lastFrame.counts;
+    double maxMs = *std::max_element(frameTimesMs.begin(), frameTimesMs.end());
+
+    std::string text = SS(
+        std::fixed << std::setprecision(2)
+                   << "frame " << Milliseconds(lastFrame.end - lastFrame.start) << "ms  max " << maxMs << "ms\n"
+                   << "anim " << Milliseconds(timings.animate)
+                   << "  meas " << Milliseconds(timings.measure)
+                   << "  arr " << Milliseconds(timings.arrange) << "\n"
+                   << "draw " << Milliseconds(timings.draw)
+                   << "  pres " << Milliseconds(timings.present) << "\n"
+                   << "damage " << counts.damageRects
+                   << "  measured " << counts.elementsMeasured
+                   << "  drawn " << counts.elementsDrawn << "\n"
+                   << "styles " << counts.styleLookups
+                   << "  surfaces " << counts.surfacesAllocated);
+    pango_layout_set_text(layout, text.c_str(), (int)text.length());
+
+    dc.save();
+    dc.rectangle(bounds);
+    dc.set_source(0, 0, 0, 0.75);
+    dc.fill();
+
+    dc.set_source(1, 1, 1);
+    dc.move_to(bounds.Left() + HUD_PADDING, bounds.Top() + HUD_PADDING);
+    pango_cairo_show_layout(dc.get(), layout);
+
+    // Frame time graph, oldest frame on the left.
+    double graphLeft = bounds.Left() + HUD_PADDING;
+    double graphBottom = bounds.Bottom() - HUD_PADDING;
+    double barWidth = (bounds.Width() - 2 * HUD_PADDING) / HISTORY_SIZE;
+    for (size_t i = 0; i < HISTORY_SIZE; ++i)
+    {
+        double ms = frameTimesMs[(historyHead + i) % HISTORY_SIZE];
+        double height = std::min(ms / GRAPH_MAX_MS, 1.0) * GRAPH_HEIGHT;
+        dc.rectangle(graphLeft + i * barWidth, graphBottom - height, barWidth, height);
+    }
+    dc.set_source(0.3, 0.8, 0.3);
+    dc.fill();
+
+    double targetY = graphBottom - TARGET_FRAME_MS / GRAPH_MAX_MS * GRAPH_HEIGHT;
+    dc.move_to(graphLeft, targetY);
+    dc.line_to(bounds.Right() - HUD_PADDING, targetY);
+    dc.set_line_width(1);
+    dc.set_source(0.9, 0.3, 0.2);
+    dc.stroke();
+    dc.restore();
+}
@@ -0,0 +1,62 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "lv2c/Lv2cInstrumentation.hpp"
+#include "lv2c/Lv2cTypes.hpp"
+#include <vector>
+
+typedef struct _PangoContext PangoContext;
+typedef struct _PangoLayout PangoLayout;
+
+namespace lv2c
+{
+    class Lv2cDrawingContext;
+
+    /// @brief Frame statistics overlay drawn over the window's content.
+    ///
+    /// Shows timings and work counts for the most recent frame, and a graph of recent frame times.
+    class Lv2cFrameStatisticsHud
+    {
+    public:
+        Lv2cFrameStatisticsHud();
+        ~Lv2cFrameStatisticsHud();
+
+        Lv2cFrameStatisticsHud(const Lv2cFrameStatisticsHud &) = delete;
+        Lv2cFrameStatisticsHud &operator=(const Lv2cFrameStatisticsHud &) = delete;
+
+        void AddFrame(const Lv2cFrameRecord &frame);
+
+        /// @brief Bounds of the overlay, in window coordinates.
+        const Lv2cRectangle &Bounds() const { return bounds; }
+
+        void Draw(Lv2cDrawingContext &dc, PangoContext *pangoContext);
+
+    private:
+        static constexpr size_t HISTORY_SIZE = 120;
+
+        Lv2cRectangle bounds;
+        Lv2cFrameRecord lastFrame;
+        std::vector<double> frameTimesMs;
+        size_t historyHead = 0;
+        PangoLayout *layout = nullptr;
+    };
+}
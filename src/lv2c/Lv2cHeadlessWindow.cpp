@@ -0,0 +1,224 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "lv2c/Lv2cHeadlessWindow.hpp"
+#include "Utf8Utils.hpp"
+#include "pango/pangocairo.h"
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace lv2c;
+
+Lv2cHeadlessWindow::Lv2cHeadlessWindow(Lv2cWindow *window, const Lv2cCreateWindowParameters &parameters)
+    : window(window),
+      surface((cairo_surface_t *)nullptr),
+      now(animation_clock_t::now())
+{
+    if (parameters.size.Width() <= 0 || parameters.size.Height() <= 0)
+    {
+        throw std::invalid_argument("Headless windows require an explicit size.");
+    }
+    CreateSurface(parameters.size);
+
+    cairo_t *cr = cairo_create(surface.get());
+    {
+        this->pangoContext = pango_cairo_create_context(cr);
+    }
+    cairo_destroy(cr);
+}
+
+Lv2cHeadlessWindow::~Lv2cHeadlessWindow()
+{
+    if (pangoContext)
+    {
+        g_object_unref(pangoContext);
+        pangoContext = nullptr;
+    }
+}
+
+void Lv2cHeadlessWindow::CreateSurface(Lv2cSize size)
+{
+    this->size = Lv2cSize(std::ceil(size.Width()), std::ceil(size.Height()));
+    surface = Lv2cImageSurface(
+        cairo_format_t::CAIRO_FORMAT_ARGB32,
+        (int)this->size.Width(), (int)this->size.Height());
+    surface.check_status();
+    window->OnX11SizeChanged(this->size);
+}
+
+void Lv2cHeadlessWindow::Resize(int width, int height)
+{
+    if (width <= 0 || height <= 0)
+    {
+        throw std::invalid_argument("Invalid window size.");
+    }
+    if (width != (int)size.Width() || height != (int)size.Height())
+    {
+        CreateSurface(Lv2cSize(width, height));
+    }
+}
+
+void Lv2cHeadlessWindow::WritePng(const std::filesystem::path &path)
+{
+    surface.flush();
+    cairo_status_t status = surface.write_to_png(path.c_str());
+    if (status != cairo_status_t::CAIRO_STATUS_SUCCESS)
+    {
+        throw std::runtime_error(std::string("Failed to write ") + path.string() + ": " + cairo_status_to_string(status));
+    }
+}
+
+void Lv2cHeadlessWindow::AdvanceTime(animation_clock_t::duration time)
+{
+    now += time;
+}
+
+void Lv2cHeadlessWindow::RenderFrame()
+{
+    if (closed)
+    {
+        return;
+    }
+    window->Animate();
+    window->Idle();
+    surface.flush();
+}
+
+void Lv2cHeadlessWindow::Run(animation_clock_t::duration time)
+{
+    while (time > animation_clock_t::duration::zero() && !closed)
+    {
+        auto step = std::min(time, FRAME_INTERVAL);
+        AdvanceTime(step);
+        RenderFrame();
+        time -= step;
+    }
+}
+
+Lv2cPoint Lv2cHeadlessWindow::ToDevice(Lv2cPoint point) const
+{
+    double scale = window->WindowScale();
+    return Lv2cPoint(std::round(point.x * scale), std::round(point.y * scale));
+}
+
+void Lv2cHeadlessWindow::MouseMove(Lv2cPoint point, ModifierState modifierState)
+{
+    if (window->ModalDisable())
+    {
+        return;
+    }
+    Lv2cPoint pt = ToDevice(point);
+    window->MouseMove(WindowHandle(), (int64_t)pt.x, (int64_t)pt.y, modifierState);
+}
+
+void Lv2cHeadlessWindow::MouseDown(Lv2cPoint point, uint64_t button, ModifierState modifierState)
+{
+    if (window->ModalDisable())
+    {
+        return;
+    }
+    Lv2cPoint pt = ToDevice(point);
+    window->MouseDown(WindowHandle(), button, (int64_t)pt.x, (int64_t)pt.y, modifierState);
+}
+
+void Lv2cHeadlessWindow::MouseUp(Lv2cPoint point, uint64_t button, ModifierState modifierState)
+{
+    Lv2cPoint pt = ToDevice(point);
+    window->MouseUp(WindowHandle(), button, (int64_t)pt.x, (int64_t)pt.y, modifierState);
+}
+
+void Lv2cHeadlessWindow::Click(Lv2cPoint point, uint64_t button, ModifierState modifierState)
+{
+    MouseMove(point, modifierState);
+    MouseDown(point, button, modifierState);
+    MouseUp(point, button, modifierState);
+}
+
+void Lv2cHeadlessWindow::ScrollWheel(Lv2cPoint point, Lv2cScrollDirection direction, ModifierState modifierState)
+{
+    if (window->ModalDisable())
+    {
+        return;
+    }
+    Lv2cPoint pt = ToDevice(point);
+    window->MouseScrollWheel(WindowHandle(), direction, (int64_t)pt.x, (int64_t)pt.y, modifierState);
+}
+
+void Lv2cHeadlessWindow::MouseLeave()
+{
+    window->MouseLeave(WindowHandle());
+}
+
+bool Lv2cHeadlessWindow::KeyDown(unsigned int keysym, ModifierState modifierState)
+{
+    if (window->ModalDisable())
+    {
+        return false;
+    }
+    Lv2cKeyboardEventArgs eventArgs;
+    eventArgs.keysymValid = true;
+    eventArgs.keysym = keysym;
+    eventArgs.modifierState = modifierState;
+    return window->OnKeyDown(eventArgs);
+}
+
+void Lv2cHeadlessWindow::TypeText(const std::string &text, ModifierState modifierState)
+{
+    size_t pos = 0;
+    while (pos < text.length())
+    {
+        if (window->ModalDisable())
+        {
+            return;
+        }
+        size_t next = Utf8Increment(pos, text);
+
+        Lv2cKeyboardEventArgs eventArgs;
+        eventArgs.textValid = true;
+        std::string character = text.substr(pos, next - pos);
+        strncpy(eventArgs.text, character.c_str(), sizeof(eventArgs.text) - 1);
+        eventArgs.modifierState = modifierState;
+        window->OnKeyDown(eventArgs);
+
+        pos = next;
+    }
+}
+
+void Lv2cHeadlessWindow::FocusIn()
+{
+    window->FireFocusIn();
+}
+
+void Lv2cHeadlessWindow::FocusOut()
+{
+    window->FireFocusOut();
+}
+
+void Lv2cHeadlessWindow::Close()
+{
+    if (!closed)
+    {
+        closed = true;
+        quitting = true;
+        window->OnClosing();
+    }
+}
@@ -0,0 +1,162 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "lv2c/Lv2cInstrumentation.hpp"
+#include "lv2c/JsonStream.hpp"
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include <cassert>
+
+using namespace lv2c;
+
+thread_local Lv2cWorkCounters lv2c::gWorkCounters;
+
+Lv2cFrameTrace::Lv2cFrameTrace(size_t maxFrames)
+    : maxFrames(std::max(maxFrames, (size_t)1))
+{
+}
+
+void Lv2cFrameTrace::Add(const Lv2cFrameRecord &frame)
+{
+    if (frames.size() < maxFrames)
+    {
+        frames.push_back(frame);
+    }
+    else
+    {
+        frames[head] = frame;
+        head = (head + 1) % maxFrames;
+    }
+}
+
+const Lv2cFrameRecord &Lv2cFrameTrace::Frame(size_t index) const
+{
+    assert(index < frames.size());
+    return frames[(head + index) % frames.size()];
+}
+
+void Lv2cFrameTrace::Clear()
+{
+    frames.clear();
+    head = 0;
+}
+
+namespace
+{
+    class TraceEventWriter
+    {
+    public:
+        TraceEventWriter(json_stream_writer &writer, Lv2cFrameRecord::time_point epoch)
+            : writer(writer), epoch(epoch)
+        {
+        }
+
+        void Complete(const char *name, Lv2cFrameRecord::time_point start, std::chrono::nanoseconds duration)
+        {
+            writer.start_object();
+            writer.member("name", name);
+            writer.member("ph", "X");
+            writer.member("pid", 1);
+            writer.member("tid", 1);
+            writer.member("ts", Microseconds(start - epoch));
+            writer.member("dur", Microseconds(duration));
+            writer.end_object();
+        }
+
+        void Counters(Lv2cFrameRecord::time_point time, const Lv2cFrameCounts &counts)
+        {
+            writer.start_object();
+            writer.member("name", "work");
+            writer.member("ph", "C");
+            writer.member("pid", 1);
+            writer.member("tid", 1);
+            writer.member("ts", Microseconds(time - epoch));
+            writer.key("args");
+            writer.start_object();
+            writer.member("damageRects", counts.damageRects);
+            writer.member("elementsMeasured", counts.elementsMeasured);
+            writer.member("elementsDrawn", counts.elementsDrawn);
+            writer.member("styleLookups", counts.styleLookups);
+            writer.member("surfacesAllocated", counts.surfacesAllocated);
+            writer.end_object();
+            writer.end_object();
+        }
+
+    private:
+        static double Microseconds(std::chrono::nanoseconds duration)
+        {
+            return std::chrono::duration<double, std::micro>(duration).count();
+        }
+
+        json_stream_writer &writer;
+        Lv2cFrameRecord::time_point epoch;
+    };
+}
+
+void Lv2cFrameTrace::Write(std::ostream &s) const
+{
+    json_stream_writer writer(s, true);
+    writer.start_object();
+    writer.key("traceEvents");
+    writer.start_array();
+    if (!frames.empty())
+    {
+        TraceEventWriter events(writer, Frame(0).start);
+        for (size_t i = 0; i < frames.size(); ++i)
+        {
+            const Lv2cFrameRecord &frame = Frame(i);
+            const Lv2cFrameTimings &timings = frame.timings;
+
+            events.Complete("frame", frame.start, frame.end - frame.start);
+            events.Complete("animate", frame.start, timings.animate);
+            // Phase times are totals for the frame (layout may run more than once, and each damage
+            // rectangle is drawn and presented separately), so sub-phases are shown back to back.
+            if (frame.layoutStart != Lv2cFrameRecord::time_point())
+            {
+                events.Complete("measure", frame.layoutStart, timings.measure);
+                events.Complete("arrange", frame.layoutStart + timings.measure, timings.arrange);
+            }
+            if (frame.drawStart != Lv2cFrameRecord::time_point())
+            {
+                events.Complete("draw", frame.drawStart, timings.draw);
+                events.Complete("present", frame.drawStart + timings.draw, timings.present);
+            }
+            events.Counters(frame.start, frame.counts);
+        }
+    }
+    writer.end_array();
+    writer.member("displayTimeUnit", "ms");
+    writer.end_object();
+}
+
+void Lv2cFrameTrace::Write(const std::filesystem::path &path) const
+{
+    std::ofstream f(path);
+    if (!f)
+    {
+        throw std::runtime_error(std::string("Can't open ") + path.string());
+    }
+    Write(f);
+    if (!f)
+    {
+        throw std::runtime_error(std::string("Failed to write ") + path.string());
+    }
+}
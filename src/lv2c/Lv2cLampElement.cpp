@@ -80,7 +80,7 @@ void Lv2cLampElement::AnimationTick(const animation_clock_time_point_t&now)
     constexpr clock_t::rep TICKS_PER_SECOND = duration_cast<clock_t::duration>(1000ms).count();
     constexpr double TICKS_TO_SECONDS = 1.0 / TICKS_PER_SECOND;
 
-    auto dt = clock_t::now() - animationStartTime;
+    auto dt = now - animationStartTime;
 
     double seconds = dt.count() * TICKS_TO_SECONDS;
 
@@ -125,7 +125,7 @@ void Lv2cLampElement::StartAnimation(double targetValue)
     if (Window())
     {
         this->animationTarget = targetValue;
-        this->animationStartTime = clock_t::now();
+        this->animationStartTime = Window()->Now();
         this->animationStartValue = AnimationValue();
         if (!animationHandle)
         {
@@ -18,48 +18,435 @@
 // CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "lv2c/Lv2cLog.hpp"
-#include "iostream"
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string_view>
+#include <functional>
 
 using namespace std;
 
 namespace lv2c
 {
+    namespace
+    {
+        constexpr size_t QUEUE_SIZE = 256; // must be a power of 2.
+        constexpr size_t MAX_MESSAGE_LENGTH = 240;
+
+        // Number of identical consecutive messages from one thread that are logged per RATE_LIMIT_WINDOW.
+        constexpr uint32_t RATE_LIMIT_BURST = 5;
+        constexpr std::chrono::steady_clock::duration RATE_LIMIT_WINDOW = std::chrono::seconds(1);
+
+        class ConsoleLogSink : public Lv2cLogSink
+        {
+        public:
+            virtual void Write(Lv2cLogLevel level, const char *message) override
+            {
+                const char *prefix;
+                switch (level)
+                {
+                case Lv2cLogLevel::Error:
+                    prefix = "Error:   ";
+                    break;
+                case Lv2cLogLevel::Warning:
+                    prefix = "Warning: ";
+                    break;
+                case Lv2cLogLevel::Info:
+                    prefix = "Info:    ";
+                    break;
+                case Lv2cLogLevel::Debug:
+                    prefix = "Debug:   ";
+                    break;
+                case Lv2cLogLevel::Trace:
+                default:
+                    prefix = "Trace:   ";
+                    break;
+                }
+                cout << prefix << message << '\n';
+            }
+            virtual void Flush() override
+            {
+                cout.flush();
+            }
+        };
+
+        // Bounded multi-producer/single-consumer queue (D. Vyukov), drained by a background thread.
+        class LogQueue
+        {
+        public:
+            LogQueue();
+
+            bool Enqueue(Lv2cLogLevel level, const char *message, Lv2cLogSink *sink);
+            void Flush();
+            void Stop();
+
+            void AddSink(Lv2cLogSink *sink);
+            void RemoveSink(Lv2cLogSink *sink);
+
+        private:
+            struct Slot
+            {
+                std::atomic<uint64_t> sequence;
+                Lv2cLogLevel level;
+                Lv2cLogSink *sink;
+                char text[MAX_MESSAGE_LENGTH];
+            };
+
+            void StartThread();
+            void ThreadProc();
+            bool Dequeue(Lv2cLogLevel *level, Lv2cLogSink **sink, char *text);
+            void WriteMessage(Lv2cLogLevel level, Lv2cLogSink *sink, const char *text);
+            void FlushSinks();
+
+            Slot slots[QUEUE_SIZE];
+            std::atomic<uint64_t> enqueuePosition{0};
+            uint64_t dequeuePosition = 0;
+            std::atomic<uint64_t> messagesWritten{0};
+            std::atomic<uint32_t> wakeCount{0};
+            std::atomic<uint64_t> droppedMessages{0};
+
+            std::atomic<bool> threadStarted{false};
+            std::atomic<bool> stopping{false};
+            std::atomic<bool> stopped{false};
+            std::mutex threadMutex;
+            std::thread thread;
+            std::thread::id threadId;
+
+            // Held by the logging thread while writing, and by AddSink/RemoveSink. Never taken by Enqueue.
+            std::recursive_mutex sinkMutex;
+            ConsoleLogSink consoleSink;
+            std::vector<Lv2cLogSink *> sinks;
+        };
+
+        LogQueue::LogQueue()
+        {
+            for (size_t i = 0; i < QUEUE_SIZE; ++i)
+            {
+                slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        bool LogQueue::Enqueue(Lv2cLogLevel level, const char *message, Lv2cLogSink *sink)
+        {
+            if (stopped.load(std::memory_order_acquire))
+            {
+                // after shutdown (static destructors, plugin unload), write synchronously.
+                std::lock_guard lock{sinkMutex};
+                WriteMessage(level, sink, message);
+                FlushSinks();
+                return true;
+            }
+            if (!threadStarted.load(std::memory_order_acquire))
+            {
+                StartThread();
+            }
+
+            Slot *slot;
+            uint64_t position = enqueuePosition.load(std::memory_order_relaxed);
+            while (true)
+            {
+                slot = &slots[position & (QUEUE_SIZE - 1)];
+                uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+                int64_t diff = (int64_t)sequence - (int64_t)position;
+                if (diff == 0)
+                {
+                    if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    // full. Never block the caller.
+                    droppedMessages.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                else
+                {
+                    position = enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+            slot->level = level;
+            slot->sink = sink;
+            size_t length = std::min(strlen(message), MAX_MESSAGE_LENGTH - 1);
+            memcpy(slot->text, message, length);
+            slot->text[length] = '\0';
+            slot->sequence.store(position + 1, std::memory_order_release);
+
+            wakeCount.fetch_add(1, std::memory_order_release);
+            wakeCount.notify_one();
+            return true;
+        }
+
+        bool LogQueue::Dequeue(Lv2cLogLevel *level, Lv2cLogSink **sink, char *text)
+        {
+            Slot *slot = &slots[dequeuePosition & (QUEUE_SIZE - 1)];
+            uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+            if (sequence != dequeuePosition + 1)
+            {
+                return false;
+            }
+            *level = slot->level;
+            *sink = slot->sink;
+            strcpy(text, slot->text);
+            slot->sequence.store(dequeuePosition + QUEUE_SIZE, std::memory_order_release);
+            ++dequeuePosition;
+            return true;
+        }
+
+        void LogQueue::StartThread()
+        {
+            std::lock_guard lock{threadMutex};
+            if (threadStarted.load(std::memory_order_relaxed) || stopping.load())
+            {
+                return;
+            }
+            thread = std::thread([this]()
+                                 { ThreadProc(); });
+            threadId = thread.get_id();
+            threadStarted.store(true, std::memory_order_release);
+        }
+
+        void LogQueue::ThreadProc()
+        {
+            char text[MAX_MESSAGE_LENGTH];
+            Lv2cLogLevel level;
+            Lv2cLogSink *sink;
+            while (true)
+            {
+                uint32_t wake = wakeCount.load(std::memory_order_acquire);
+                uint64_t written = 0;
+                {
+                    std::lock_guard lock{sinkMutex};
+                    while (Dequeue(&level, &sink, text))
+                    {
+                        WriteMessage(level, sink, text);
+                        ++written;
+                    }
+                    uint64_t dropped = droppedMessages.exchange(0, std::memory_order_relaxed);
+                    if (dropped != 0)
+                    {
+                        std::string message = "Log queue overflow. " + std::to_string(dropped) + " message(s) dropped.";
+                        WriteMessage(Lv2cLogLevel::Warning, nullptr, message.c_str());
+                    }
+                    if (written != 0 || dropped != 0)
+                    {
+                        FlushSinks(); // once per batch, not once per line.
+                    }
+                }
+                if (written != 0)
+                {
+                    messagesWritten.fetch_add(written, std::memory_order_release);
+                    messagesWritten.notify_all();
+                    continue;
+                }
+                if (stopping.load(std::memory_order_acquire))
+                {
+                    break;
+                }
+                wakeCount.wait(wake, std::memory_order_acquire);
+            }
+        }
+
+        void LogQueue::WriteMessage(Lv2cLogLevel level, Lv2cLogSink *sink, const char *text)
+        {
+            if (sink == nullptr || std::find(sinks.begin(), sinks.end(), sink) == sinks.end())
+            {
+                // unknown sinks may have been removed since the message was queued.
+                sink = sinks.empty() ? &consoleSink : sinks.back();
+            }
+            sink->Write(level, text);
+        }
+
+        void LogQueue::FlushSinks()
+        {
+            consoleSink.Flush();
+            for (auto sink : sinks)
+            {
+                sink->Flush();
+            }
+        }
+
+        void LogQueue::Flush()
+        {
+            if (!threadStarted.load(std::memory_order_acquire) || stopped.load(std::memory_order_acquire))
+            {
+                return;
+            }
+            if (std::this_thread::get_id() == threadId)
+            {
+                return; // called from a sink.
+            }
+            // Messages are dequeued in order, so once the logging thread has written as many messages
+            // as had been enqueued, everything enqueued before this call has been written.
+            uint64_t target = enqueuePosition.load(std::memory_order_acquire);
+            while (true)
+            {
+                uint64_t written = messagesWritten.load(std::memory_order_acquire);
+                if (written >= target)
+                {
+                    break;
+                }
+                messagesWritten.wait(written, std::memory_order_acquire);
+            }
+        }
+
+        void LogQueue::Stop()
+        {
+            {
+                std::lock_guard lock{threadMutex};
+                stopping.store(true, std::memory_order_release);
+            }
+            if (thread.joinable())
+            {
+                wakeCount.fetch_add(1, std::memory_order_release);
+                wakeCount.notify_one();
+                thread.join();
+            }
+            std::lock_guard lock{sinkMutex};
+            stopped.store(true, std::memory_order_release);
+
+            // write messages that were queued while the thread was exiting.
+            char text[MAX_MESSAGE_LENGTH];
+            Lv2cLogLevel level;
+            Lv2cLogSink *sink;
+            while (Dequeue(&level, &sink, text))
+            {
+                WriteMessage(level, sink, text);
+            }
+            FlushSinks();
+        }
+
+        void LogQueue::AddSink(Lv2cLogSink *sink)
+        {
+            std::lock_guard lock{sinkMutex};
+            sinks.push_back(sink);
+        }
+
+        void LogQueue::RemoveSink(Lv2cLogSink *sink)
+        {
+            Flush();
+            std::lock_guard lock{sinkMutex};
+            sink->Flush();
+            auto f = std::find(sinks.begin(), sinks.end(), sink);
+            if (f != sinks.end())
+            {
+                sinks.erase(f);
+            }
+        }
+
+        LogQueue &GetLogQueue()
+        {
+            // Never deleted: messages may be logged by static destructors that run after shutdown.
+            static LogQueue *queue = new LogQueue();
+            return *queue;
+        }
+
+        // Joins the logging thread when the process exits, or when a plugin that links lv2c is unloaded.
+        class LogShutdown
+        {
+        public:
+            ~LogShutdown()
+            {
+                GetLogQueue().Stop();
+            }
+        };
+        LogShutdown logShutdown;
+
+        struct RateLimitState
+        {
+            size_t hash = 0;
+            Lv2cLogLevel level = Lv2cLogLevel::Nothing;
+            Lv2cLogSink *sink = nullptr;
+            std::chrono::steady_clock::time_point windowStart;
+            uint32_t count = 0;
+            uint32_t suppressed = 0;
+        };
+        thread_local RateLimitState rateLimitState;
 
-    static Lv2cLogLevel logLevel = Lv2cLogLevel::Debug;
+        std::atomic<Lv2cLogLevel> logLevel{Lv2cLogLevel::Info};
+    }
 
     void SetLogLevel(Lv2cLogLevel logLevel_)
     {
-        lv2c::logLevel = logLevel_;
+        lv2c::logLevel.store(logLevel_, std::memory_order_relaxed);
+    }
+    Lv2cLogLevel GetLogLevel()
+    {
+        return lv2c::logLevel.load(std::memory_order_relaxed);
     }
 
-    void LogError(const std::string &message)
+    bool LogEnabled(Lv2cLogLevel level)
     {
-        if (logLevel >= Lv2cLogLevel::Error)
-        {
-            cout << "Error:   " << message << endl;
-        }
+        return level != Lv2cLogLevel::Nothing && level <= lv2c::logLevel.load(std::memory_order_relaxed);
     }
 
-    void LogWarning(const std::string &message)
+    void Log(Lv2cLogLevel level, const char *message, Lv2cLogSink *sink)
     {
-        if (logLevel >= Lv2cLogLevel::Warning)
+        if (!LogEnabled(level))
         {
-            cout << "Warning: " << message << endl;
+            return;
         }
-    }
+        auto now = std::chrono::steady_clock::now();
+        size_t hash = std::hash<std::string_view>()(std::string_view(message)) ^ (size_t)level;
 
-    void LogInfo(const std::string &message)
-    {
-        if (logLevel >= Lv2cLogLevel::Info)
+        RateLimitState &state = rateLimitState;
+        if (hash == state.hash && level == state.level && sink == state.sink && now - state.windowStart < RATE_LIMIT_WINDOW)
         {
-            cout << "Info:    " << message << endl;
+            if (++state.count > RATE_LIMIT_BURST)
+            {
+                ++state.suppressed;
+                return;
+            }
         }
-    }
-    void LogDebug(const std::string &message)
-    {
-        if (logLevel >= Lv2cLogLevel::Debug)
+        else
         {
-            cout << "Debug:   " << message << endl;
+            if (state.suppressed != 0)
+            {
+                std::string repeated = "(Last message repeated " + std::to_string(state.suppressed) + " more times.)";
+                GetLogQueue().Enqueue(state.level, repeated.c_str(), state.sink);
+            }
+            state.hash = hash;
+            state.level = level;
+            state.sink = sink;
+            state.windowStart = now;
+            state.count = 1;
+            state.suppressed = 0;
         }
+        GetLogQueue().Enqueue(level, message, sink);
+    }
+
+    void AddLogSink(Lv2cLogSink *sink)
+    {
+        GetLogQueue().AddSink(sink);
+    }
+    void RemoveLogSink(Lv2cLogSink *sink)
+    {
+        GetLogQueue().RemoveSink(sink);
+    }
+
+    void FlushLog()
+    {
+        GetLogQueue().Flush();
+    }
+
+    void LogError(const std::string &message)
+    {
+        Log(Lv2cLogLevel::Error, message.c_str());
+    }
+
+    void LogWarning(const std::string &message)
+    {
+        Log(Lv2cLogLevel::Warning, message.c_str());
+    }
+
+    void LogInfo(const std::string &message)
+    {
+        Log(Lv2cLogLevel::Info, message.c_str());
     }
 }
@@ -0,0 +1,185 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "lv2c/Lv2cMeterBallistics.hpp"
+#include "lv2c/Lv2cWindow.hpp"
+#include <algorithm>
+#include <cassert>
+
+using namespace lv2c;
+
+static constexpr double HOLD_SECONDS = std::chrono::duration<double>(Lv2cMeterBallistics::HOLD_TIME).count();
+static constexpr double DECAY_SECONDS = std::chrono::duration<double>(Lv2cMeterBallistics::DECAY_TIME).count();
+
+Lv2cMeterBallistics::Lv2cMeterBallistics(Lv2cWindow *window)
+    : window(window),
+      epoch(window->Now())
+{
+}
+
+Lv2cMeterBallistics::~Lv2cMeterBallistics()
+{
+    if (animationHandle && window)
+    {
+        window->CancelAnimationCallback(animationHandle);
+    }
+}
+
+double Lv2cMeterBallistics::Seconds(const animation_clock_time_point_t &time) const
+{
+    return std::chrono::duration<double>(time - epoch).count();
+}
+
+Lv2cMeterBallistics::channel_id Lv2cMeterBallistics::AddChannel(Lv2cMeterBallisticsClient *client, size_t clientChannel, double value, double range)
+{
+    channel_id channel;
+    if (!freeChannels.empty())
+    {
+        channel = freeChannels.back();
+        freeChannels.pop_back();
+    }
+    else
+    {
+        channel = (channel_id)hold.size();
+        level.push_back(0);
+        hold.push_back(0);
+        decayStartValue.push_back(0);
+        decayStartTime.push_back(0);
+        decayRate.push_back(0);
+        active.push_back(0);
+        clients.push_back(nullptr);
+        clientChannels.push_back(0);
+    }
+    level[channel] = value;
+    hold[channel] = value;
+    decayStartValue[channel] = value;
+    decayStartTime[channel] = 0;
+    active[channel] = 0;
+    clients[channel] = client;
+    clientChannels[channel] = clientChannel;
+    Range(channel, range);
+    return channel;
+}
+
+void Lv2cMeterBallistics::RemoveChannel(channel_id channel)
+{
+    assert(channel < hold.size() && clients[channel] != nullptr);
+    if (active[channel])
+    {
+        active[channel] = 0;
+        --activeChannels;
+    }
+    clients[channel] = nullptr;
+    freeChannels.push_back(channel);
+
+    if (activeChannels == 0 && animationHandle && window)
+    {
+        window->CancelAnimationCallback(animationHandle);
+        animationHandle = AnimationHandle::InvalidHandle;
+    }
+}
+
+void Lv2cMeterBallistics::Range(channel_id channel, double range)
+{
+    decayRate[channel] = std::abs(range) / DECAY_SECONDS;
+}
+
+double Lv2cMeterBallistics::Level(channel_id channel, double value)
+{
+    level[channel] = value;
+    if (value > hold[channel])
+    {
+        // new peak. Hold, then decay.
+        hold[channel] = value;
+        decayStartValue[channel] = value;
+        decayStartTime[channel] = Seconds(window->Now()) + HOLD_SECONDS;
+    }
+    else if (active[channel] || value == hold[channel])
+    {
+        return hold[channel];
+    }
+    else
+    {
+        // the level has dropped below an idle hold value. Decay immediately.
+        decayStartValue[channel] = hold[channel];
+        decayStartTime[channel] = Seconds(window->Now());
+    }
+    if (!active[channel])
+    {
+        active[channel] = 1;
+        ++activeChannels;
+    }
+    RequestTick();
+    return hold[channel];
+}
+
+void Lv2cMeterBallistics::RequestTick()
+{
+    if (!animationHandle && window)
+    {
+        animationHandle = window->RequestAnimationCallback(
+            [this](const animation_clock_time_point_t &now)
+            {
+                Tick(now);
+            });
+    }
+}
+
+void Lv2cMeterBallistics::Tick(const animation_clock_time_point_t &now)
+{
+    animationHandle = AnimationHandle::InvalidHandle;
+
+    double t = Seconds(now);
+    size_t size = hold.size();
+
+    changedChannels.clear();
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (!active[i])
+        {
+            continue;
+        }
+        double elapsed = std::max(t - decayStartTime[i], 0.0);
+        double newHold = decayStartValue[i] - elapsed * decayRate[i];
+        if (newHold <= level[i])
+        {
+            newHold = level[i];
+            active[i] = 0;
+            --activeChannels;
+        }
+        if (newHold != hold[i])
+        {
+            hold[i] = newHold;
+            changedChannels.push_back((channel_id)i);
+        }
+    }
+
+    // Notify after all channels have been updated, since clients may add or remove channels.
+    for (channel_id channel : changedChannels)
+    {
+        if (clients[channel])
+        {
+            clients[channel]->OnMeterHoldChanged(clientChannels[channel], hold[channel]);
+        }
+    }
+    if (activeChannels != 0)
+    {
+        RequestTick();
+    }
+}
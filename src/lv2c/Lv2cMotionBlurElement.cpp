@@ -20,10 +20,155 @@
 #include "lv2c/Lv2cMotionBlurElement.hpp"
 #include "lv2c/Lv2cDrawingContext.hpp"
 #include "lv2c/Lv2cWindow.hpp"
+#include "lv2c/Lv2cSurfacePool.hpp"
 #include <cmath>
 #include <cassert>
+#include <vector>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 using namespace lv2c;
+using namespace lv2c::implementation;
+
+namespace
+{
+    // A premultiplied pixel with linear intensities, as four floats in image surface
+    // (B,G,R,A) order. The blur sums every channel the same way, so the order never
+    // needs to be swizzled.
+#if defined(__SSE2__)
+    using pixel_t = __m128;
+    inline pixel_t pixel_zero() { return _mm_setzero_ps(); }
+    inline pixel_t pixel_load(const float *p) { return _mm_loadu_ps(p); }
+    inline void pixel_store(float *p, pixel_t v) { _mm_storeu_ps(p, v); }
+    inline pixel_t pixel_add(pixel_t a, pixel_t b) { return _mm_add_ps(a, b); }
+    inline pixel_t pixel_sub(pixel_t a, pixel_t b) { return _mm_sub_ps(a, b); }
+    inline pixel_t pixel_mul(pixel_t a, float scale) { return _mm_mul_ps(a, _mm_set1_ps(scale)); }
+    inline pixel_t pixel_from_surface(const uint8_t *p)
+    {
+        return _mm_set_ps(srgb2i[p[3]], srgb2i[p[2]], srgb2i[p[1]], srgb2i[p[0]]);
+    }
+    inline void pixel_to_surface(pixel_t v, uint8_t *dest)
+    {
+        constexpr size_t inverse_table_size = sizeof(i2srgb) / sizeof(i2srgb[0]);
+        constexpr float TABLE_CONVERSION_FACTOR = inverse_table_size - 2;
+
+        if (_mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3))) <= 0)
+        {
+            *(uint32_t *)dest = 0;
+            return;
+        }
+        v = _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+        __m128 indexF = _mm_mul_ps(v, _mm_set1_ps(TABLE_CONVERSION_FACTOR));
+        __m128i index = _mm_cvttps_epi32(indexF);
+        __m128 frac = _mm_sub_ps(indexF, _mm_cvtepi32_ps(index));
+
+        alignas(16) int32_t ix[4];
+        _mm_store_si128((__m128i *)ix, index);
+        __m128 lo = _mm_set_ps(i2srgb[ix[3]], i2srgb[ix[2]], i2srgb[ix[1]], i2srgb[ix[0]]);
+        __m128 hi = _mm_set_ps(i2srgb[ix[3] + 1], i2srgb[ix[2] + 1], i2srgb[ix[1] + 1], i2srgb[ix[0] + 1]);
+        __m128 result = _mm_add_ps(lo, _mm_mul_ps(_mm_sub_ps(hi, lo), frac));
+
+        __m128i bytes = _mm_cvttps_epi32(result);
+        bytes = _mm_packs_epi32(bytes, bytes);
+        bytes = _mm_packus_epi16(bytes, bytes);
+        *(uint32_t *)dest = (uint32_t)_mm_cvtsi128_si32(bytes);
+    }
+#elif defined(__ARM_NEON)
+    using pixel_t = float32x4_t;
+    inline pixel_t pixel_zero() { return vdupq_n_f32(0); }
+    inline pixel_t pixel_load(const float *p) { return vld1q_f32(p); }
+    inline void pixel_store(float *p, pixel_t v) { vst1q_f32(p, v); }
+    inline pixel_t pixel_add(pixel_t a, pixel_t b) { return vaddq_f32(a, b); }
+    inline pixel_t pixel_sub(pixel_t a, pixel_t b) { return vsubq_f32(a, b); }
+    inline pixel_t pixel_mul(pixel_t a, float scale) { return vmulq_n_f32(a, scale); }
+    inline pixel_t pixel_from_surface(const uint8_t *p)
+    {
+        float v[4] = {srgb2i[p[0]], srgb2i[p[1]], srgb2i[p[2]], srgb2i[p[3]]};
+        return vld1q_f32(v);
+    }
+    inline void pixel_to_surface(pixel_t v, uint8_t *dest)
+    {
+        if (vgetq_lane_f32(v, 3) <= 0)
+        {
+            *(uint32_t *)dest = 0;
+            return;
+        }
+        float c[4];
+        vst1q_f32(c, v);
+        dest[0] = IToSrgb(c[0]);
+        dest[1] = IToSrgb(c[1]);
+        dest[2] = IToSrgb(c[2]);
+        dest[3] = IToSrgb(c[3]);
+    }
+#else
+    struct pixel_t
+    {
+        float v[4];
+    };
+    inline pixel_t pixel_zero() { return pixel_t{{0, 0, 0, 0}}; }
+    inline pixel_t pixel_load(const float *p) { return pixel_t{{p[0], p[1], p[2], p[3]}}; }
+    inline void pixel_store(float *p, pixel_t v)
+    {
+        for (int i = 0; i < 4; ++i)
+            p[i] = v.v[i];
+    }
+    inline pixel_t pixel_add(pixel_t a, pixel_t b)
+    {
+        for (int i = 0; i < 4; ++i)
+            a.v[i] += b.v[i];
+        return a;
+    }
+    inline pixel_t pixel_sub(pixel_t a, pixel_t b)
+    {
+        for (int i = 0; i < 4; ++i)
+            a.v[i] -= b.v[i];
+        return a;
+    }
+    inline pixel_t pixel_mul(pixel_t a, float scale)
+    {
+        for (int i = 0; i < 4; ++i)
+            a.v[i] *= scale;
+        return a;
+    }
+    inline pixel_t pixel_from_surface(const uint8_t *p)
+    {
+        return pixel_t{{srgb2i[p[0]], srgb2i[p[1]], srgb2i[p[2]], srgb2i[p[3]]}};
+    }
+    inline void pixel_to_surface(pixel_t v, uint8_t *dest)
+    {
+        if (v.v[3] <= 0)
+        {
+            *(uint32_t *)dest = 0;
+            return;
+        }
+        for (int i = 0; i < 4; ++i)
+            dest[i] = IToSrgb(v.v[i]);
+    }
+#endif
+
+    // acc += weight * source, for a row of surface pixels.
+    void AccumulateRow(float *acc, const uint8_t *source, int width, float weight)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            pixel_t v = pixel_mul(pixel_from_surface(source + 4 * x), weight);
+            pixel_store(acc + 4 * x, pixel_add(pixel_load(acc + 4 * x), v));
+        }
+    }
+
+    void StoreRow(const float *source, uint8_t *dest, int width, float scale)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            pixel_to_surface(pixel_mul(pixel_load(source + 4 * x), scale), dest + 4 * x);
+        }
+    }
+}
 
 Lv2cMotionBlurElement::Lv2cMotionBlurElement()
 {
@@ -36,288 +181,127 @@ bool Lv2cMotionBlurElement::WillDraw() const
     return true;
 }
 
-Lv2cImageSurface Lv2cMotionBlurElement::MotionBlurFilter(Lv2cImageSurface &surface, Lv2cPoint from, Lv2cPoint to)
+void Lv2cMotionBlurElement::MotionBlurFilter(Lv2cImageSurface &surface, Lv2cImageSurface &result, Lv2cPoint from, Lv2cPoint to)
 {
     surface.flush();
 
-    int sourceWidth = surface.get_width();
-    int sourceHeight = surface.get_height();
+    int width = surface.get_width();
+    int height = surface.get_height();
     int sourceStride = surface.get_stride();
-    Lv2cImageSurface result{cairo_format_t::CAIRO_FORMAT_ARGB32, sourceWidth, sourceHeight};
+    int destStride = result.get_stride();
+    assert(result.get_width() == width && result.get_height() == height);
 
-    uint8_t *sourceData = surface.get_data();
+    const uint8_t *sourceData = surface.get_data();
     uint8_t *destData = result.get_data();
 
-        //std::cout << "from.y: " << from.y <<  " to.y: " << to.y << std::endl;
-
+    auto SourceRow = [sourceData, sourceStride, height](int y) -> const uint8_t *
+    {
+        if (y < 0 || y >= height)
+            return nullptr;
+        return sourceData + (ptrdiff_t)sourceStride * y;
+    };
 
     if (from.x == to.x)
     {
+        std::vector<float> acc((size_t)width * 4);
+
         if (std::abs(to.y - from.y) <= 1)
         {
-            // linear blend.
-
-            double yVal = to.y;
-            (void)yVal;
-            
-            std::vector<Lv2cLinearColor> line0Buffer;
-            line0Buffer.resize(sourceWidth);
-            std::vector<Lv2cLinearColor> line1Buffer;
-            line1Buffer.resize(sourceWidth);
-
-            std::vector<Lv2cLinearColor> lineResult;
-            lineResult.resize(sourceWidth);
-
-            double blend0 = (from.y - std::floor(from.y));
-            //std::cout << "blend0: " << blend0 << std::endl;
-            double blend1 = 1 - blend0;
-            int iy = std::floor(from.y);
-            for (int y = 0; y < sourceHeight; ++y)
+            // Sub-pixel vertical translation: blend two adjacent source lines.
+            float blend0 = (float)(from.y - std::floor(from.y));
+            float blend1 = 1 - blend0;
+            int iy = (int)std::floor(from.y);
+            for (int y = 0; y < height; ++y)
             {
-                int y0Source = y - iy-1;
-                int y1Source = y - iy ;
-                                uint8_t *pSource0 = sourceData + (sourceStride * y0Source);
-                uint8_t *pSource1 = pSource0 + sourceStride;
-
-                if (y0Source >= 0 && y0Source < sourceHeight)
+                std::fill(acc.begin(), acc.end(), 0.0f);
+                if (auto row = SourceRow(y - iy - 1))
                 {
-                    Lv2cLinearColor::FromImageSurface(pSource0, line0Buffer);
-                    if (y1Source >= 0 && y1Source < sourceHeight)
-                    {
-                        // both lines good.
-                        Lv2cLinearColor::FromImageSurface(pSource1, line1Buffer);
-                        for (int x = 0; x < sourceWidth; ++x)
-                        {
-                            lineResult[x] = line0Buffer[x] * blend0 + line1Buffer[x] * blend1;
-                        }
-                    }
-                    else
-                    {
-                        // first line good.
-                        for (int x = 0; x < sourceWidth; ++x)
-                        {
-                            lineResult[x] = line0Buffer[x] * blend0;
-                        }
-                    }
+                    AccumulateRow(acc.data(), row, width, blend0);
                 }
-                else
+                if (auto row = SourceRow(y - iy))
                 {
-                    if (y1Source >= 0 && y1Source < sourceHeight)
-                    {
-                        // second line good.
-                        Lv2cLinearColor::FromImageSurface(pSource1, line1Buffer);
-                        for (int x = 0; x < sourceWidth; ++x)
-                        {
-                            lineResult[x] = line1Buffer[x] * blend1;
-                        }
-                    }
-                    else
-                    {
-                        // neithter valid.
-                        for (int x = 0; x < sourceWidth; ++x)
-                        {
-                            lineResult[x] = Lv2cLinearColor();
-                        }
-                    }
+                    AccumulateRow(acc.data(), row, width, blend1);
                 }
-                unsigned char *pDest = destData + y * sourceStride;
-                Lv2cLinearColor::ToImageSurface(lineResult, pDest);
+                StoreRow(acc.data(), destData + (ptrdiff_t)destStride * y, width, 1.0f);
             }
         }
         else
         {
-            if (to.y < from.y)
-            {
-                std::swap(from, to);
-            }
-
-            int yFrom = (int)std::round(from.y);
-            int yTo = (int)std::round(to.y);
-            if (yTo == yFrom)
+            // result(y) = average of source(y-d), for d in [dFrom,dTo).
+            int dFrom = (int)std::round(std::min(from.y, to.y));
+            int dTo = (int)std::round(std::max(from.y, to.y));
+            if (dTo == dFrom)
             {
-                yTo = yFrom + 1;
+                dTo = dFrom + 1;
             }
-            int bufferSize = (yTo - yFrom);
-
-            std::vector<Lv2cLinearColor> lineBufferMemory;
-            lineBufferMemory.resize(sourceWidth * bufferSize);
-
-            std::vector<Lv2cLinearColor> currentLine;
-
-            auto GetBufferLine = [&lineBufferMemory, sourceWidth, bufferSize](int y)
-            {
-                y = y % (int)bufferSize;
-                if (y < 0)
-                    y += bufferSize;
-                assert(y < (int)bufferSize);
-                assert((y + 1) * sourceWidth <= (int)(lineBufferMemory.size()));
-                return &(lineBufferMemory[sourceWidth * y]);
-            };
-            std::vector<Lv2cLinearColor> runningLine;
-            runningLine.resize(sourceWidth);
+            float scale = 1.0f / (float)(dTo - dFrom);
 
-            // Calculate lead-in lines.
-            if (yFrom < 0)
+            // Running sum for y = -1.
+            for (int d = dFrom; d < dTo; ++d)
             {
-                for (int y = -bufferSize; y < 0; ++y)
+                if (auto row = SourceRow(-1 - d))
                 {
-                    auto bufferLine = GetBufferLine(y + bufferSize);
-                    int ySource = (int)(y - yFrom);
-
-                    if (ySource >= 0 && ySource < sourceHeight)
-                    {
-                        uint8_t *pSource = sourceData + (sourceStride * ySource);
-                        for (int x = 0; x < sourceWidth; ++x)
-                        {
-                            Lv2cLinearColor c = Lv2cLinearColor::FromImageSurfaceColor(pSource[2], pSource[1], pSource[0], pSource[3]);
-                            bufferLine[x] = c;
-                            runningLine[x] += c;
-                            pSource += 4;
-                        }
-                    }
+                    AccumulateRow(acc.data(), row, width, 1.0f);
                 }
             }
-
-            float scale = 1.0f / (float)bufferSize;
-            (void)scale;
-            for (int y = 0; y < sourceHeight; ++y)
+            for (int y = 0; y < height; ++y)
             {
-                int ySource = (int)(y - yTo);
-                auto bufferLine = GetBufferLine(y);
-                for (int x = 0; x < sourceWidth; ++x)
-                {
-                    runningLine[x] -= bufferLine[x];
-                }
-                if (ySource >= 0 && ySource < sourceHeight)
+                if (auto row = SourceRow(y - dFrom))
                 {
-                    uint8_t *pSource = sourceData + (sourceStride * ySource);
-                    for (int x = 0; x < sourceWidth; ++x)
-                    {
-                        Lv2cLinearColor c = Lv2cLinearColor::FromImageSurfaceColor(
-                            (uint8_t)(pSource[2]),
-                            (uint8_t)(pSource[1]),
-                            (uint8_t)(pSource[0]),
-                            (uint8_t(pSource[3])));
-                        bufferLine[x] = c;
-                        runningLine[x] += c;
-                        pSource += 4;
-                    }
+                    AccumulateRow(acc.data(), row, width, 1.0f);
                 }
-                else
+                if (auto row = SourceRow(y - dTo))
                 {
-                    for (int x = 0; x < sourceWidth; ++x)
-                    {
-                        bufferLine[x] = Lv2cLinearColor();
-                    }
+                    AccumulateRow(acc.data(), row, width, -1.0f);
                 }
-
-                uint8_t *pDest = destData + sourceStride * y;
-                Lv2cLinearColor::ToImageSurface((size_t)sourceWidth, &(runningLine[0]), pDest, scale);
-
-                assert(result.get_stride() == surface.get_stride());
-
-                // Memory is in BGRA order.
-                // pDest = destData + sourceStride*y;
-                //  for (size_t x = 0; x < sourceWidth; ++x)
-                //  {
-                //      pDest[0] = 0x80; //B
-                //      pDest[1] = 0x0; //G
-                //      pDest[2] = 0x0;  //R
-                //      pDest[3] = 0x80; //A
-                //      pDest += 4;
-                //  }
-                //  assert (result.get_stride() == surface.get_stride());
+                StoreRow(acc.data(), destData + (ptrdiff_t)destStride * y, width, scale);
             }
         }
-        result.mark_dirty();
-        return result;
     }
     else if (from.y == to.y)
     {
-        int xFrom = (int)std::round(from.x);
-        int xTo = (int)std::round(to.x);
-
-        if (xFrom == xTo)
+        // result(x) = average of source(x-d), for d in [dFrom,dTo).
+        int dFrom = (int)std::round(std::min(from.x, to.x));
+        int dTo = (int)std::round(std::max(from.x, to.x));
+        if (dTo == dFrom)
         {
-            xTo = xFrom + 1;
+            dTo = dFrom + 1;
         }
-        if (xFrom > xTo)
-        {
-            std::swap(xFrom, xTo);
-        }
-
-        int bufferSize = (size_t)(xTo - xFrom);
+        float scale = 1.0f / (float)(dTo - dFrom);
 
-        std::vector<Lv2cLinearColor> columnBufferMemory;
-        columnBufferMemory.resize(bufferSize);
+        // One line of linear pixels, with enough transparent padding on either side
+        // that the running sum never needs a bounds check.
+        int padding = std::max(std::abs(dFrom), std::abs(dTo)) + 1;
+        std::vector<float> lineBuffer((size_t)(width + 2 * padding) * 4);
+        float *line = lineBuffer.data() + 4 * padding;
 
-        float scale = 1.0f / (float)bufferSize;
-
-        std::vector<Lv2cLinearColor> currentLine;
-        currentLine.resize(sourceWidth);
-
-        for (int y = 0; y < sourceHeight; ++y)
+        for (int y = 0; y < height; ++y)
         {
-
-            // zero out the buffer.
-            columnBufferMemory.resize(0);
-            columnBufferMemory.resize(bufferSize);
-
-            Lv2cLinearColor runningColor;
-
-            uint8_t *sourceLine = sourceData + sourceStride * y;
-
-            // Calculate lead-in columns
-            for (int x = -bufferSize; x < 0; ++x)
+            const uint8_t *pSource = SourceRow(y);
+            for (int x = 0; x < width; ++x)
             {
-                int xSource = (int)(x - xFrom);
-
-                if (xSource >= 0 && xSource < sourceWidth)
-                {
-                    uint8_t *pSource = sourceLine + xSource * 4;
-                    Lv2cLinearColor c = Lv2cLinearColor::FromImageSurfaceColor(pSource[2], pSource[1], pSource[0], pSource[3]);
-                    int bufferX = (x + bufferSize) % bufferSize;
-
-                    columnBufferMemory[bufferX] = c;
-                    runningColor += c;
-                }
+                pixel_store(line + 4 * x, pixel_from_surface(pSource + 4 * x));
             }
 
-            uint8_t *pSource = sourceLine - xFrom * 4;
-
-            for (int x = 0; x < sourceWidth; ++x)
+            pixel_t running = pixel_zero();
+            for (int d = dFrom; d < dTo; ++d)
             {
-                int xSource = (int)(x - xFrom);
-                auto &bufferX = columnBufferMemory[x % bufferSize];
-                runningColor -= bufferX;
-                if (xSource >= 0 && xSource < sourceWidth)
-                {
-                    Lv2cLinearColor c = Lv2cLinearColor::FromImageSurfaceColor(
-                        (uint8_t)(pSource[2]),
-                        (uint8_t)(pSource[1]),
-                        (uint8_t)(pSource[0]),
-                        (uint8_t(pSource[3])));
-                    bufferX = c;
-                    runningColor += c;
-                }
-                else
-                {
-                    bufferX = Lv2cLinearColor();
-                }
-                pSource += 4;
-
-                currentLine[x] = runningColor;
+                running = pixel_add(running, pixel_load(line + 4 * (-1 - d)));
+            }
+            uint8_t *pDest = destData + (ptrdiff_t)destStride * y;
+            for (int x = 0; x < width; ++x)
+            {
+                running = pixel_add(running, pixel_load(line + 4 * (x - dFrom)));
+                running = pixel_sub(running, pixel_load(line + 4 * (x - dTo)));
+                pixel_to_surface(pixel_mul(running, scale), pDest + 4 * x);
             }
-            uint8_t *pDest = destData + sourceStride * y;
-            Lv2cLinearColor::ToImageSurface((size_t)sourceWidth, &(currentLine[0]), pDest, scale);
         }
-        result.mark_dirty();
-        return result;
     }
     else
     {
         throw std::runtime_error("Not supported. Blur must be either horizontal or vertical");
     }
+    result.mark_dirty();
 }
 
 void Lv2cMotionBlurElement::DrawPostOpacity(Lv2cDrawingContext &dc, const Lv2cRectangle &clipBounds)
@@ -347,37 +331,49 @@ void Lv2cMotionBlurElement::DrawPostOpacity(Lv2cDrawingContext &dc, const Lv2cRe
         }
         return;
     }
-    // TODO: Don't draw ENTIRE screenRect: respect the clipBounds.
 
-    // Capture the contents rendered at device scale.
-    Lv2cRectangle boundsRect = this->ScreenBounds();
-    if (boundsRect.Empty())
+    // Only pixels inside the clip rectangle are blurred. Those are affected by
+    // source pixels up to the blur extent away, so capture that much more.
+    Lv2cRectangle elementBounds = this->ScreenBounds();
+    Lv2cRectangle clip = clipBounds.Intersect(elementBounds);
+    if (clip.Empty())
     {
         return;
     }
+    double extentX = std::ceil(std::max(std::abs(From().x), std::abs(To().x))) + 1;
+    double extentY = std::ceil(std::max(std::abs(From().y), std::abs(To().y))) + 1;
+    Lv2cRectangle captureBounds = clip.Inflate(extentX, extentY, extentX, extentY).Intersect(elementBounds);
 
-    Lv2cRectangle deviceRectangle = dc.user_to_device(boundsRect).Ceiling();
+    // Capture the contents rendered at device scale.
+    Lv2cRectangle deviceRectangle = dc.user_to_device(captureBounds).Ceiling();
     Lv2cRectangle userRectangle = dc.device_to_user(deviceRectangle);
+    int deviceWidth = (int)std::round(deviceRectangle.Width());
+    int deviceHeight = (int)std::round(deviceRectangle.Height());
 
-    Lv2cImageSurface renderSurface{
-        cairo_format_t::CAIRO_FORMAT_ARGB32,
-        (int)std::round(deviceRectangle.Width()),
-        (int)std::round(deviceRectangle.Height())};
-
-    Lv2cDrawingContext bufferDc(renderSurface);
-    bufferDc.scale(deviceRectangle.Width() / userRectangle.Width(), deviceRectangle.Height() / userRectangle.Height());
+    Lv2cSurfacePool &surfacePool = Window()->SurfacePool();
+    Lv2cImageSurface renderSurface = surfacePool.Acquire(
+        cairo_format_t::CAIRO_FORMAT_ARGB32, deviceWidth, deviceHeight);
+    {
+        Lv2cDrawingContext bufferDc(renderSurface);
+        bufferDc.scale(deviceRectangle.Width() / userRectangle.Width(), deviceRectangle.Height() / userRectangle.Height());
+        bufferDc.translate(-userRectangle.Left(), -userRectangle.Top());
 
-    bufferDc.translate(-userRectangle.Left(), -userRectangle.Top());
+        super::DrawPostOpacity(bufferDc, userRectangle);
+    }
 
-    super::DrawPostOpacity(bufferDc, clipBounds);
+    Lv2cPoint deviceFrom = dc.user_to_device_distance(From());
+    Lv2cPoint deviceTo = dc.user_to_device_distance(To());
 
-    Lv2cPoint deviceFrom = dc.device_to_user_distance(From());
-    Lv2cPoint deviceTo = dc.device_to_user_distance(To());
+    // Every pixel of the result is written by the filter, so it doesn't need clearing.
+    Lv2cImageSurface filteredSurface = surfacePool.Acquire(
+        cairo_format_t::CAIRO_FORMAT_ARGB32, deviceWidth, deviceHeight, false);
+    MotionBlurFilter(renderSurface, filteredSurface, deviceFrom, deviceTo);
 
-    Lv2cSurface filteredSurface = MotionBlurFilter(renderSurface, deviceFrom, deviceTo);
     // Put the modified contents back.
     dc.save();
     {
+        dc.rectangle(clip);
+        dc.clip();
         dc.translate(userRectangle.Left(), userRectangle.Top());
         dc.scale(userRectangle.Width() / deviceRectangle.Width(), userRectangle.Height() / deviceRectangle.Height());
         dc.rectangle(Lv2cRectangle(0, 0, deviceRectangle.Width(), deviceRectangle.Height()));
@@ -458,7 +458,7 @@ void Lv2cScrollBarElement::AnimationTick(const animation_clock_time_point_t &now
 void Lv2cScrollBarElement::StartAnimation(double targetValue)
 {
     this->animationTarget = targetValue;
-    this->lastAnimationTime = animation_clock_t::now();
+    this->lastAnimationTime = Window()->Now();
     if (!animationHandle)
     {
         animationHandle = Window()->RequestAnimationCallback(
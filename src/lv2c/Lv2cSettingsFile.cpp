@@ -27,6 +27,9 @@
 #include <fstream>
 #include <filesystem>
 #include <cstdlib>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
 #include "lv2c/Lv2cLog.hpp"
 #include "ss.hpp"
 
@@ -74,22 +77,16 @@ void Lv2cSettingsFile::Load(const std::string &identifier)
     if (std::filesystem::exists(path))
     {
         try {
-        std::ifstream f;
-        f.open(path);
-        f.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-        if (f.is_open())
-        {
-            json_reader reader(f);
+            json_file_reader reader(path);
 
             root.read(reader);
 
             {
                 std::stringstream s;
                 s << root;
+                std::lock_guard lock{writeMutex};
                 this->lastValue = s.str();
             }
-
-        }
         } catch(const std::exception &e)
         {
             LogError(SS("Invalid settings file." << e.what()));
@@ -104,35 +101,207 @@ void Lv2cSettingsFile::Update()
     s << root;
 
     std::string newValue = s.str();
-    bool written = false;
 
-    if (newValue != this->lastValue)
     {
-        std::filesystem::path tmpPath = 
-            std::filesystem::path(
-                filePath.string() + ".$$$"
-            );
-        std::filesystem::path directory = filePath.parent_path();
+        // lastValue only changes once a write succeeds, so a failed write is retried by the next Update().
+        std::lock_guard lock{writeMutex};
+        if (writePending ? newValue == pendingValue : newValue == lastValue)
+        {
+            return;
+        }
+    }
 
-        std::filesystem::create_directories(directory);
+    if (writeBehindDelay.count() == 0)
+    {
+        Flush(); // so that an older pending value doesn't overwrite this one.
+        if (!WriteFile(filePath, newValue))
         {
-            std::ofstream f(tmpPath);
-            f << newValue << std::endl;
-            if (f)
-            {
-                written = true;
-            }
+            LogError(SS("Failed to write settings file " << filePath));
+            return;
+        }
+        std::lock_guard lock{writeMutex};
+        lastValue = std::move(newValue);
+        return;
+    }
+    {
+        std::lock_guard lock{writeMutex};
+        if (writePending)
+        {
+            ++writesAvoided;
+        }
+        else
+        {
+            writeDeadline = std::chrono::steady_clock::now() + writeBehindDelay;
+        }
+        pendingValue = std::move(newValue);
+        pendingPath = filePath;
+        writePending = true;
+        if (!writerThread.joinable())
+        {
+            writerClosing = false;
+            writerThread = std::thread([this]() { WriterThreadProc(); });
+        }
+    }
+    writeCv.notify_all();
+}
+
+void Lv2cSettingsFile::Flush()
+{
+    std::unique_lock lock{writeMutex};
+    writeCv.wait(lock, [this]() { return !writeInProgress; });
+    if (!writePending)
+    {
+        return;
+    }
+    std::string value = std::move(pendingValue);
+    std::filesystem::path path = pendingPath;
+    writePending = false;
+    writeInProgress = true;
+    lock.unlock();
+
+    bool written = WriteFile(path, value);
+    if (!written)
+    {
+        LogError(SS("Failed to write settings file " << path));
+    }
+
+    lock.lock();
+    if (written)
+    {
+        lastValue = std::move(value);
+    }
+    writeInProgress = false;
+    writeCv.notify_all();
+}
+
+void Lv2cSettingsFile::WriterThreadProc()
+{
+    std::unique_lock lock{writeMutex};
+    while (true)
+    {
+        writeCv.wait(lock, [this]() { return writePending || writerClosing; });
+        if (!writePending)
+        {
+            break;
+        }
+        // coalesce further updates until the deadline.
+        while (!writerClosing && std::chrono::steady_clock::now() < writeDeadline)
+        {
+            writeCv.wait_until(lock, writeDeadline);
+        }
+        // one write at a time (Flush() may be writing on another thread).
+        writeCv.wait(lock, [this]() { return !writeInProgress; });
+        if (!writePending)
+        {
+            continue;
         }
+        std::string value = std::move(pendingValue);
+        std::filesystem::path path = pendingPath;
+        writePending = false;
+        writeInProgress = true;
+        lock.unlock();
+
+        bool written = WriteFile(path, value);
+        if (!written)
+        {
+            LogError(SS("Failed to write settings file " << path));
+        }
+
+        lock.lock();
         if (written)
         {
-            std::filesystem::remove(this->filePath);
-            std::filesystem::rename(tmpPath,filePath);
+            lastValue = std::move(value);
+        }
+        writeInProgress = false;
+        writeCv.notify_all();
+    }
+}
+
+void Lv2cSettingsFile::StopWriterThread()
+{
+    {
+        std::lock_guard lock{writeMutex};
+        writerClosing = true;
+    }
+    writeCv.notify_all();
+    if (writerThread.joinable())
+    {
+        writerThread.join();
+    }
+}
+
+/*static*/ bool Lv2cSettingsFile::WriteFile(const std::filesystem::path &path, const std::string &value)
+{
+    // Write to a temporary file, and then atomically replace the original.
+    std::filesystem::path tmpPath =
+        std::filesystem::path(
+            path.string() + ".$$$"
+        );
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd == -1)
+    {
+        return false;
+    }
+    std::string data = value + "\n";
+    const char *p = data.c_str();
+    size_t remaining = data.length();
+    bool written = true;
+    while (remaining != 0)
+    {
+        ssize_t n = write(fd, p, remaining);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            written = false;
+            break;
         }
+        p += n;
+        remaining -= n;
+    }
+    if (written && fsync(fd) != 0)
+    {
+        written = false;
     }
+    close(fd);
+    if (!written)
+    {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    std::filesystem::rename(tmpPath, path, ec);
+    return !ec;
+}
+
+std::chrono::milliseconds Lv2cSettingsFile::WriteBehindDelay() const
+{
+    return writeBehindDelay;
 }
+
+Lv2cSettingsFile &Lv2cSettingsFile::WriteBehindDelay(std::chrono::milliseconds delay)
+{
+    writeBehindDelay = delay;
+    if (delay.count() == 0)
+    {
+        Flush();
+    }
+    return *this;
+}
+
+uint64_t Lv2cSettingsFile::WritesAvoided() const
+{
+    std::lock_guard lock{writeMutex};
+    return writesAvoided;
+}
+
 Lv2cSettingsFile::~Lv2cSettingsFile()
 {
     Update();
+    // writes any pending update before exiting.
+    StopWriterThread();
     if (sharedInstanceidentifier.length() != 0)
     {
         sharedInstances[this->sharedInstanceidentifier] = nullptr;
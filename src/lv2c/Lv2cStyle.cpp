@@ -20,6 +20,7 @@
 #include "lv2c/Lv2cStyle.hpp"
 #include "lv2c/Lv2cElement.hpp"
 #include "lv2c/Lv2cTheme.hpp"
+#include "lv2c/Lv2cInstrumentation.hpp"
 
 using namespace lv2c;
 
@@ -52,6 +53,7 @@ T Lv2cStyle::FromSelfOrClassesT(std::optional<T> Lv2cStyle::*pMember, T defaultV
     {
         return result.value();
     }
+    ++gWorkCounters.styleLookups;
     if (this->element)
     {
 
@@ -330,6 +332,7 @@ const Lv2cMeasurement &Lv2cStyle::FromSelfOrClasses(InheritMeasurementPtr pMembe
     const Lv2cMeasurement &result = (this->*pMember);
     if (result.isEmpty())
     {
+        ++gWorkCounters.styleLookups;
         if (this->element)
         {
 
@@ -351,6 +354,7 @@ const Lv2cMeasurement &Lv2cStyle::FromSelfOrClassesOrParent(InheritMeasurementPt
     const Lv2cMeasurement &result = (this->*pMember);
     if (result.isEmpty())
     {
+        ++gWorkCounters.styleLookups;
         if (this->element)
         {
 
@@ -381,6 +385,7 @@ const Lv2cPattern &Lv2cStyle::FromSelfOrClasses(InheritPatternPtr pMember) const
     const Lv2cPattern &result = (this->*pMember);
     if (result.isEmpty())
     {
+        ++gWorkCounters.styleLookups;
         if (this->element)
         {
 
@@ -402,6 +407,7 @@ const Lv2cPattern &Lv2cStyle::FromSelfOrClassesOrParent(InheritPatternPtr pMembe
     const Lv2cPattern &result = (this->*pMember);
     if (result.isEmpty())
     {
+        ++gWorkCounters.styleLookups;
         if (this->element)
         {
 
@@ -432,6 +438,7 @@ const std::string &Lv2cStyle::FromSelfOrClassesOrParent(InheritStringPtr pMember
     const std::string &result = (this->*pMember);
     if (result.length() == 0)
     {
+        ++gWorkCounters.styleLookups;
         if (this->element)
         {
 
@@ -463,6 +470,7 @@ inline std::shared_ptr<T> Lv2cStyle::FromSelfOrClassesOrParent(InheritOptionalSh
     std::shared_ptr<T> result = (this->*pMember);
     if (!result)
     {
+        ++gWorkCounters.styleLookups;
         if (this->element)
         {
 
@@ -494,6 +502,7 @@ inline std::optional<T> Lv2cStyle::FromSelfOrClassesOrParent(Lv2cStyle::InheritO
     std::optional<T> result = (this->*pMember);
     if (!result.has_value())
     {
+        ++gWorkCounters.styleLookups;
         if (this->element)
         {
 
@@ -525,6 +534,7 @@ inline std::optional<T> Lv2cStyle::FromSelfOrClasses(Lv2cStyle::InheritOptionalP
     std::optional<T> result = (this->*pMember);
     if (!result.has_value())
     {
+        ++gWorkCounters.styleLookups;
         if (this->element)
         {
 
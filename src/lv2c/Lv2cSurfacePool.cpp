@@ -0,0 +1,226 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "lv2c/Lv2cSurfacePool.hpp"
+#include "lv2c/Lv2cInstrumentation.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+using namespace lv2c;
+
+static constexpr size_t MIN_SIZE_CLASS = 4096;
+static constexpr size_t BUFFER_ALIGNMENT = 64;
+
+static cairo_user_data_key_t leaseKey;
+
+struct Lv2cSurfacePool::Lease
+{
+    std::weak_ptr<Lv2cSurfacePool> pool;
+    Buffer buffer;
+};
+
+Lv2cSurfacePool::Lv2cSurfacePool()
+{
+}
+
+Lv2cSurfacePool::~Lv2cSurfacePool()
+{
+    // Surfaces that are still in use free their own buffers when destroyed.
+    Clear();
+}
+
+size_t Lv2cSurfacePool::SizeClass(size_t bytes)
+{
+    // Four size classes per power of two, so at most 25% of a buffer is wasted.
+    if (bytes <= MIN_SIZE_CLASS)
+    {
+        return MIN_SIZE_CLASS;
+    }
+    size_t step = std::bit_floor(bytes) / 4;
+    return (bytes + step - 1) / step * step;
+}
+
+void Lv2cSurfacePool::FreeBuffer(Buffer &buffer)
+{
+    std::free(buffer.data);
+    buffer.data = nullptr;
+}
+
+Lv2cImageSurface Lv2cSurfacePool::Acquire(cairo_format_t format, int width, int height, bool clear)
+{
+    int stride = cairo_format_stride_for_width(format, width);
+    if (width <= 0 || height <= 0 || stride <= 0)
+    {
+        return Lv2cImageSurface(format, std::max(width, 0), std::max(height, 0));
+    }
+    size_t bytes = (size_t)stride * (size_t)height;
+    size_t sizeClass = SizeClass(bytes);
+
+    Buffer buffer;
+    auto iter = std::upper_bound(
+        freeBuffers.begin(), freeBuffers.end(), sizeClass,
+        [](size_t size, const Buffer &buffer)
+        { return size < buffer.size; });
+    if (iter != freeBuffers.begin() && (iter - 1)->size == sizeClass)
+    {
+        --iter;
+        buffer = *iter;
+        freeBuffers.erase(iter);
+        freeBytes -= buffer.size;
+    }
+    else
+    {
+        buffer.size = sizeClass;
+        buffer.data = std::aligned_alloc(BUFFER_ALIGNMENT, sizeClass);
+        if (buffer.data == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        ++allocations;
+        ++gWorkCounters.surfacesAllocated;
+    }
+    if (clear)
+    {
+        std::memset(buffer.data, 0, bytes);
+    }
+
+    cairo_surface_t *surface = cairo_image_surface_create_for_data(
+        (unsigned char *)buffer.data, format, width, height, stride);
+    Lease *lease = new Lease{weak_from_this(), buffer};
+    if (cairo_surface_status(surface) != cairo_status_t::CAIRO_STATUS_SUCCESS ||
+        cairo_surface_set_user_data(surface, &leaseKey, lease, OnSurfaceDestroyed) != cairo_status_t::CAIRO_STATUS_SUCCESS)
+    {
+        cairo_status_t status = cairo_surface_status(surface);
+        cairo_surface_destroy(surface);
+        delete lease;
+        Return(std::move(buffer));
+        throw std::runtime_error(cairo_status_to_string(status));
+    }
+    bytesInUse += buffer.size;
+    peakBytes = std::max(peakBytes, bytesInUse + freeBytes);
+    return Lv2cImageSurface(surface);
+}
+
+void Lv2cSurfacePool::OnSurfaceDestroyed(void *data)
+{
+    std::unique_ptr<Lease> lease{(Lease *)data};
+    auto pool = lease->pool.lock();
+    if (pool)
+    {
+        pool->bytesInUse -= lease->buffer.size;
+        pool->Return(std::move(lease->buffer));
+    }
+    else
+    {
+        FreeBuffer(lease->buffer);
+    }
+}
+
+void Lv2cSurfacePool::Return(Buffer &&buffer)
+{
+    if (buffer.size > highWaterMark)
+    {
+        FreeBuffer(buffer);
+        return;
+    }
+    auto now = clock_t::now();
+    EvictTo(highWaterMark - buffer.size);
+
+    buffer.lastUsed = now;
+    auto iter = std::upper_bound(
+        freeBuffers.begin(), freeBuffers.end(), buffer.size,
+        [](size_t size, const Buffer &buffer)
+        { return size < buffer.size; });
+    freeBytes += buffer.size;
+    freeBuffers.insert(iter, buffer);
+    peakBytes = std::max(peakBytes, bytesInUse + freeBytes);
+}
+
+Lv2cSurfacePool &Lv2cSurfacePool::HighWaterMark(size_t bytes)
+{
+    highWaterMark = bytes;
+    EvictTo(highWaterMark);
+    return *this;
+}
+
+Lv2cSurfacePool &Lv2cSurfacePool::IdleTimeout(std::chrono::milliseconds timeout)
+{
+    idleTimeout = timeout;
+    nextTrimTime = clock_t::time_point();
+    return *this;
+}
+
+void Lv2cSurfacePool::Trim()
+{
+    if (freeBuffers.empty())
+    {
+        return;
+    }
+    auto now = clock_t::now();
+    if (now < nextTrimTime)
+    {
+        return;
+    }
+    // Checking a quarter of the timeout at a time keeps idle cost negligible.
+    nextTrimTime = now + idleTimeout / 4;
+
+    auto expired = now - idleTimeout;
+    auto end = std::remove_if(
+        freeBuffers.begin(), freeBuffers.end(),
+        [this, expired](Buffer &buffer)
+        {
+            if (buffer.lastUsed > expired)
+            {
+                return false;
+            }
+            freeBytes -= buffer.size;
+            FreeBuffer(buffer);
+            return true;
+        });
+    freeBuffers.erase(end, freeBuffers.end());
+}
+
+void Lv2cSurfacePool::EvictTo(size_t maxBytes)
+{
+    // Evict least-recently-used buffers until the pool fits.
+    while (freeBytes > maxBytes)
+    {
+        auto oldest = std::min_element(
+            freeBuffers.begin(), freeBuffers.end(),
+            [](const Buffer &left, const Buffer &right)
+            { return left.lastUsed < right.lastUsed; });
+        freeBytes -= oldest->size;
+        FreeBuffer(*oldest);
+        freeBuffers.erase(oldest);
+    }
+}
+
+void Lv2cSurfacePool::Clear()
+{
+    for (auto &buffer : freeBuffers)
+    {
+        FreeBuffer(buffer);
+    }
+    freeBuffers.clear();
+    freeBytes = 0;
+}
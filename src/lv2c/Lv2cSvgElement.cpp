@@ -149,9 +149,22 @@ double Lv2cSvgElement::Rotation() const
     return RotationProperty.get();
 }
 
+Lv2cSvgElement &Lv2cSvgElement::InvalidateOnRotation(bool value)
+{
+    invalidateOnRotation = value;
+    return *this;
+}
+bool Lv2cSvgElement::InvalidateOnRotation() const
+{
+    return invalidateOnRotation;
+}
+
 void Lv2cSvgElement::OnRotationChanged(double value)
 {
-    Invalidate();
+    if (invalidateOnRotation)
+    {
+        Invalidate();
+    }
 }
 void Lv2cSvgElement::OnSourceChanged(const std::string&value)
 {
@@ -83,7 +83,7 @@ void Lv2cSwitchElement::AnimationTick(const animation_clock_time_point_t&now)
     bool finished = false;
     if (now != lastAnimationTime)
     {
-        clock_t::rep elapsed = (clock_t::now() - lastAnimationTime).count();
+        clock_t::rep elapsed = (now - lastAnimationTime).count();
         double elapsedSeconds = elapsed * SECONDS_PER_TICK;
         double dPosition = elapsedSeconds * ANIMATION_RATE;
 
@@ -152,7 +152,7 @@ void Lv2cSwitchElement::StartAnimation()
         Position(Checked() ? 1.0 : 0.0);
         Invalidate();
     }
-    lastAnimationTime = clock_t::now();
+    lastAnimationTime = this->Window()->Now();
     animationHandle = this->Window()->RequestAnimationCallback(
         [this](const animation_clock_time_point_t&now)
         {
@@ -312,7 +312,8 @@ void Lv2cToggleTrackElement::OnDraw(Lv2cDrawingContext &dc)
 }
 Lv2cToggleTrackElement::Lv2cToggleTrackElement()
 {
-    PositionProperty.SetElement(this, Lv2cBindingFlags::InvalidateOnChanged);
+    // Position changes are invalidated by Lv2cSwitchElement::ValueDirtyRect().
+    PositionProperty.SetElement(this, Lv2cBindingFlags::Empty);
 }
 void Lv2cToggleTrackElement::OnMount()
 {
@@ -348,7 +349,8 @@ void Lv2cToggleThumbElement::OnDraw(Lv2cDrawingContext &dc)
 }
 Lv2cToggleThumbElement::Lv2cToggleThumbElement()
 {
-    PositionProperty.SetElement(this, Lv2cBindingFlags::InvalidateOnChanged);
+    // Position changes are invalidated by Lv2cSwitchElement::ValueDirtyRect().
+    PositionProperty.SetElement(this, Lv2cBindingFlags::Empty);
     PressedProperty.SetElement(this, Lv2cBindingFlags::InvalidateOnChanged);
 }
 
@@ -380,4 +382,41 @@ Lv2cSwitchElement::Lv2cSwitchElement()
 
     PositionProperty.Bind(track->PositionProperty);
     PositionProperty.Bind(thumb->PositionProperty);
+    PositionProperty.SetElement(this, &Lv2cSwitchElement::OnPositionChanged);
+}
+
+void Lv2cSwitchElement::OnPositionChanged(double value)
+{
+    InvalidateValueChange(displayedPosition, value);
+    displayedPosition = value;
+}
+
+Lv2cRectangle Lv2cSwitchElement::ValueDirtyRect(double oldValue, double newValue)
+{
+    const Lv2cRectangle &clientBounds = ScreenClientBounds();
+
+    // The thumb, at both positions, plus the shadow it casts.
+    const Lv2cRectangle &thumbBounds = thumb->ScreenClientBounds();
+    double thumbSize = thumbBounds.Height();
+    double travel = thumbBounds.Width() - thumbSize;
+    double left = thumbBounds.Left() - clientBounds.Left() + std::min(oldValue, newValue) * travel;
+    double right = thumbBounds.Left() - clientBounds.Left() + std::max(oldValue, newValue) * travel + thumbSize;
+    Lv2cRectangle result{left, thumbBounds.Top() - clientBounds.Top(), right - left, thumbSize};
+
+    double shadowX = thumbShadow->Radius() + std::abs(thumbShadow->XOffset()) + 1;
+    double shadowY = thumbShadow->Radius() + std::abs(thumbShadow->YOffset()) + 1;
+    result = result.Inflate(shadowX, shadowY, shadowX, shadowY);
+
+    if (IsOnOff())
+    {
+        // the boundary between the on and off colors of the track.
+        const Lv2cRectangle &trackBounds = track->ScreenClientBounds();
+        double trackTravel = trackBounds.Width() - trackBounds.Height();
+        double x0 = trackBounds.Left() - clientBounds.Left() + std::min(oldValue, newValue) * trackTravel;
+        double x1 = trackBounds.Left() - clientBounds.Left() + std::max(oldValue, newValue) * trackTravel + trackBounds.Height();
+        result = result.Union(Lv2cRectangle(
+            x0, trackBounds.Top() - clientBounds.Top(),
+            x1 - x0, trackBounds.Height()).Inflate(1));
+    }
+    return result;
 }
\ No newline at end of file
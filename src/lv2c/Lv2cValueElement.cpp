@@ -30,6 +30,24 @@ void Lv2cValueElement::OnValueChanged(double value)
 {
 }
 
+Lv2cRectangle Lv2cValueElement::ValueDirtyRect(double oldValue, double newValue)
+{
+    return ClientRectangle();
+}
+
+void Lv2cValueElement::InvalidateValueChange(double oldValue, double newValue)
+{
+    if (oldValue == newValue)
+    {
+        return;
+    }
+    Lv2cRectangle dirtyRect = ValueDirtyRect(oldValue, newValue);
+    if (!dirtyRect.Empty())
+    {
+        InvalidateClientRect(dirtyRect);
+    }
+}
+
 Lv2cStereoValueElement::Lv2cStereoValueElement()
 {
     RightValueProperty.SetElement(this, &Lv2cStereoValueElement::OnRightValueChanged);
@@ -18,6 +18,7 @@
 // CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "lv2c/Lv2cVuElement.hpp"
+#include <cmath>
 
 using namespace lv2c;
 
@@ -60,6 +61,79 @@ double Lv2cVuElement::ValueToClient(double value, double minValue, double maxVal
     return v;
 }
 
+/*static*/
+Lv2cRectangle Lv2cVuElement::VuRectangle(const Lv2cRectangle &clientRectangle, const Lv2cVuSettings &settings)
+{
+    Lv2cRectangle vuRectangle = clientRectangle.Inflate(-settings.padding);
+    if (settings.hasTicks)
+    {
+        double offsetX = settings.tickWidth + settings.padding;
+
+        vuRectangle = Lv2cRectangle(vuRectangle.Left() + offsetX, vuRectangle.Top(), vuRectangle.Width() - offsetX, vuRectangle.Height());
+    }
+    return vuRectangle;
+}
+
+/*static*/
+void Lv2cVuElement::SplitStereoVuRectangle(const Lv2cRectangle &vuRectangle, const Lv2cVuSettings &settings, Lv2cRectangle *left, Lv2cRectangle *right)
+{
+    double vuWidth = (vuRectangle.Width()-settings.padding)/2;
+
+    *left = Lv2cRectangle{ vuRectangle.Left(),vuRectangle.Top(),vuWidth,vuRectangle.Height()};
+    *right = Lv2cRectangle{ vuRectangle.Right()-vuWidth,vuRectangle.Top(),vuWidth,vuRectangle.Height()};
+}
+
+/*static*/
+Lv2cRectangle Lv2cVuElement::LevelChangeRect(
+    const Lv2cRectangle &vuRectangle,
+    double minValue,
+    double maxValue,
+    double value0,
+    double value1)
+{
+    double y0 = ValueToClient(value0, minValue, maxValue, vuRectangle);
+    double y1 = ValueToClient(value1, minValue, maxValue, vuRectangle);
+    if (y0 > y1)
+    {
+        std::swap(y0, y1);
+    }
+    // Allow for device pixel rounding, the minimum bar height, and the height of a
+    // telltale, all of which extend a pixel or two beyond the nominal level.
+    constexpr double MARGIN = 3;
+    return Lv2cRectangle(
+        std::floor(vuRectangle.Left()) - 1,
+        std::floor(y0) - MARGIN,
+        std::ceil(vuRectangle.Width()) + 2,
+        std::ceil(y1 - y0) + 2 * MARGIN);
+}
+
+Lv2cRectangle Lv2cVuElement::ValueDirtyRect(double oldValue, double newValue)
+{
+    Lv2cRectangle vuRectangle = VuRectangle(ClientRectangle(), Settings());
+    return LevelChangeRect(vuRectangle, MinValue(), MaxValue(), oldValue, newValue);
+}
+
+void Lv2cStereoVuElement::VuBarRectangles(Lv2cRectangle *left, Lv2cRectangle *right)
+{
+    auto &settings = Settings();
+    Lv2cRectangle vuRectangle = Lv2cVuElement::VuRectangle(ClientRectangle(), settings);
+    Lv2cVuElement::SplitStereoVuRectangle(vuRectangle, settings, left, right);
+}
+
+Lv2cRectangle Lv2cStereoVuElement::ValueDirtyRect(double oldValue, double newValue)
+{
+    Lv2cRectangle left, right;
+    VuBarRectangles(&left, &right);
+    return Lv2cVuElement::LevelChangeRect(left, MinValue(), MaxValue(), oldValue, newValue);
+}
+
+Lv2cRectangle Lv2cStereoVuElement::RightValueDirtyRect(double oldValue, double newValue)
+{
+    Lv2cRectangle left, right;
+    VuBarRectangles(&left, &right);
+    return Lv2cVuElement::LevelChangeRect(right, MinValue(), MaxValue(), oldValue, newValue);
+}
+
 void Lv2cVuElement::OnDraw(Lv2cDrawingContext &dc)
 {
     super::OnDraw(dc);
@@ -69,13 +143,7 @@ void Lv2cVuElement::OnDraw(Lv2cDrawingContext &dc)
     Lv2cRectangle deviceRect = dc.user_to_device(clientRectangle).Ceiling();
     clientRectangle = dc.device_to_user(deviceRect);
 
-    Lv2cRectangle vuRectangle = clientRectangle.Inflate(-settings.padding);
-    if (settings.hasTicks)
-    {
-        double offsetX = settings.tickWidth + settings.padding;
-
-        vuRectangle = Lv2cRectangle(vuRectangle.Left() + offsetX, vuRectangle.Top(), vuRectangle.Width() - offsetX, vuRectangle.Height());
-    }
+    Lv2cRectangle vuRectangle = VuRectangle(clientRectangle, settings);
     DrawVu(dc,Value(),MinValue(),MaxValue(), vuRectangle, Settings());
 }
 void Lv2cStereoVuElement::OnDraw(Lv2cDrawingContext &dc)
@@ -87,19 +155,11 @@ void Lv2cStereoVuElement::OnDraw(Lv2cDrawingContext &dc)
     Lv2cRectangle deviceRect = dc.user_to_device(clientRectangle).Ceiling();
     clientRectangle = dc.device_to_user(deviceRect);
 
-    Lv2cRectangle vuRectangle = clientRectangle.Inflate(-settings.padding);
-    if (settings.hasTicks)
-    {
-        double offsetX = settings.tickWidth + settings.padding;
-
-        vuRectangle = Lv2cRectangle(vuRectangle.Left() + offsetX, vuRectangle.Top(), vuRectangle.Width() - offsetX, vuRectangle.Height());
-    }
-    double vuWidth = (vuRectangle.Width()-settings.padding)/2;
+    Lv2cRectangle vuRectangle = Lv2cVuElement::VuRectangle(clientRectangle, settings);
 
-    Lv2cRectangle leftVu { vuRectangle.Left(),vuRectangle.Top(),vuWidth,vuRectangle.Height()};
+    Lv2cRectangle leftVu, rightVu;
+    Lv2cVuElement::SplitStereoVuRectangle(vuRectangle, settings, &leftVu, &rightVu);
     Lv2cVuElement::DrawVu(dc,Value(),MinValue(),MaxValue(), leftVu, Settings());
-
-    Lv2cRectangle rightVu { vuRectangle.Right()-vuWidth,vuRectangle.Top(),vuWidth,vuRectangle.Height()};
     Lv2cVuElement::DrawVu(dc,RightValue(),MinValue(),MaxValue(), rightVu, Settings());
 
 }
@@ -189,17 +249,23 @@ void Lv2cVuElement::DrawVu(
 void Lv2cVuElement::OnValueChanged(double value)
 {
     super::OnValueChanged(value);
-    Invalidate();
+    InvalidateValueChange(displayedValue, value);
+    displayedValue = value;
 }
 
 void Lv2cStereoVuElement::OnValueChanged(double value)
 {
     super::OnValueChanged(value);
-    Invalidate();
+    InvalidateValueChange(displayedValue, value);
+    displayedValue = value;
 }
 
 void Lv2cStereoVuElement::OnRightValueChanged(double value)
 {
-    super::OnValueChanged(value);
-    Invalidate();
+    super::OnRightValueChanged(value);
+    if (value != displayedRightValue)
+    {
+        InvalidateClientRect(RightValueDirtyRect(displayedRightValue, value));
+    }
+    displayedRightValue = value;
 }
\ No newline at end of file
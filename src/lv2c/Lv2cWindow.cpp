@@ -21,6 +21,9 @@
 #include "lv2c/Lv2cDrawingContext.hpp"
 #include "lv2c/Lv2cContainerElement.hpp"
 #include "lv2c/Lv2cSvg.hpp"
+#include "lv2c/Lv2cSurfacePool.hpp"
+#include "lv2c/Lv2cMeterBallistics.hpp"
+#include "lv2c/Lv2cHeadlessWindow.hpp"
 #include "lv2c/Lv2cSettingsFile.hpp"
 #include "lv2c/Lv2cMessageDialog.hpp"
 
@@ -42,6 +45,7 @@ using namespace lv2c;
 #include "ss.hpp"
 
 #include "Lv2cX11Window.hpp"
+#include "Lv2cFrameStatisticsHud.hpp"
 #include "lv2c/Lv2cRootElement.hpp"
 
 std::vector<std::filesystem::path> Lv2cWindow::resourceDirectories;
@@ -65,6 +69,7 @@ Lv2cWindow::Lv2cWindow()
     auto rootWindow = Lv2cRootElement::Create();
     rootWindow->Style().Theme(this->theme);
     this->rootElement = rootWindow;
+    this->surfacePool = Lv2cSurfacePool::Create();
 }
 
 Lv2cWindow::~Lv2cWindow()
@@ -82,6 +87,20 @@ std::shared_ptr<Lv2cRootElement> Lv2cWindow::GetRootElement()
     return rootElement;
 }
 
+Lv2cSurfacePool &Lv2cWindow::SurfacePool()
+{
+    return *surfacePool;
+}
+
+Lv2cMeterBallistics &Lv2cWindow::MeterBallistics()
+{
+    if (!meterBallistics)
+    {
+        meterBallistics = std::make_unique<Lv2cMeterBallistics>(this);
+    }
+    return *meterBallistics;
+}
+
 void Lv2cWindow::Invalidate()
 {
     Lv2cSize size = Size();
@@ -104,18 +123,28 @@ void Lv2cWindow::OnExpose(WindowHandle h, int64_t x, int64_t y, int64_t width, i
 
 Lv2cDrawingContext Lv2cWindow::CreateDrawingContext()
 {
-    return Lv2cDrawingContext(nativeWindow->GetSurface());
+    return Lv2cDrawingContext(NativeSurface());
+}
+
+cairo_surface_t *Lv2cWindow::NativeSurface()
+{
+    if (headlessWindow)
+    {
+        return headlessWindow->Surface().get();
+    }
+    return nativeWindow->GetSurface();
 }
 
 void Lv2cWindow::Draw()
 {
-    cairo_surface_t *surface = nativeWindow->GetSurface();
+    cairo_surface_t *surface = NativeSurface();
 
     Lv2cDrawingContext context{surface};
 
     auto damageRects = this->damageList.GetDamageList();
     if (damageRects.size() == 0)
         return;
+    currentFrame.counts.damageRects += damageRects.size();
     for (auto &damageRect : damageRects)
     {
 
@@ -136,6 +165,11 @@ void Lv2cWindow::Draw()
 
             context.check_status();
 
+            auto drawStart = std::chrono::steady_clock::now();
+            if (currentFrame.drawStart == Lv2cFrameRecord::time_point())
+            {
+                currentFrame.drawStart = drawStart;
+            }
             context.push_group_with_content(cairo_content_t::CAIRO_CONTENT_COLOR);
             OnDraw(context);
             if (rootElement)
@@ -144,6 +178,7 @@ void Lv2cWindow::Draw()
             }
             OnDrawOver(context);
             context.check_status();
+            auto presentStart = std::chrono::steady_clock::now();
             context.pop_group_to_source();
 
             context.check_status();
@@ -152,6 +187,9 @@ void Lv2cWindow::Draw()
             context.rectangle(displayRect);
             context.fill();
             context.set_operator(t);
+            auto presentEnd = std::chrono::steady_clock::now();
+            frameTimings.draw += presentStart - drawStart;
+            frameTimings.present += presentEnd - presentStart;
         }
         catch (const std::exception &e)
         {
@@ -191,6 +229,10 @@ void Lv2cWindow::Close()
     {
         this->nativeWindow->Close();
     }
+    else if (this->headlessWindow)
+    {
+        this->headlessWindow->Close();
+    }
 }
 
 void Lv2cWindow::CloseRootWindow()
@@ -266,8 +308,36 @@ void Lv2cWindow::CreateWindow(
     CreateWindow(WindowHandle(), parameters);
 }
 
+Lv2cHeadlessWindow &Lv2cWindow::CreateHeadlessWindow(const Lv2cCreateWindowParameters &parameters)
+{
+    if (this->nativeWindow || this->headlessWindow)
+    {
+        throw std::logic_error("Window has already been created.");
+    }
+    this->windowParameters = parameters;
+    if (settings.is_null())
+    {
+        settings = this->windowParameters.settingsObject;
+    }
+    Lv2cCreateWindowParameters scaledParameters = Scale(windowParameters, windowScale);
+    this->headlessWindow = std::unique_ptr<Lv2cHeadlessWindow>(
+        new Lv2cHeadlessWindow(this, scaledParameters));
+
+    if (this->rootElement)
+    {
+        rootElement->Mount(this);
+    }
+    return *headlessWindow;
+}
+
 bool Lv2cWindow::PumpMessages(bool block)
 {
+    if (headlessWindow)
+    {
+        // Headless windows have no event source; render a frame at the current synthetic time.
+        headlessWindow->RenderFrame();
+        return headlessWindow->Quitting();
+    }
     if (block)
     {
         if (nativeWindow == nullptr)
@@ -397,6 +467,11 @@ void Lv2cWindow::MouseMove(WindowHandle h, int64_t x, int64_t y, ModifierState s
     this->lastMouseEventArgs = event;
     OnMouseMove(event);
 }
+bool Lv2cWindow::WantsAllMouseMotion() const
+{
+    return !coalesceMouseMotion || (captureElement && captureElement->WantsAllMouseMotion());
+}
+
 void Lv2cWindow::MouseLeave(WindowHandle h)
 {
     if (this->GetRootElement() != nullptr)
@@ -411,6 +486,10 @@ void Lv2cWindow::PostQuit()
     {
         this->nativeWindow->PostQuit();
     }
+    else if (this->headlessWindow)
+    {
+        this->headlessWindow->PostQuit();
+    }
 }
 bool Lv2cWindow::Quitting() const
 {
@@ -418,12 +497,19 @@ bool Lv2cWindow::Quitting() const
     {
         return this->nativeWindow->Quitting();
     }
+    if (this->headlessWindow)
+    {
+        return this->headlessWindow->Quitting();
+    }
     return true;
 }
 
 void Lv2cWindow::TraceEvents(bool trace)
 {
-    nativeWindow->TraceEvents(trace);
+    if (nativeWindow)
+    {
+        nativeWindow->TraceEvents(trace);
+    }
 }
 
 void Lv2cWindow::OnDraw(Lv2cDrawingContext &dc)
@@ -431,6 +517,10 @@ void Lv2cWindow::OnDraw(Lv2cDrawingContext &dc)
 }
 void Lv2cWindow::OnDrawOver(Lv2cDrawingContext &dc)
 {
+    if (frameStatisticsHud)
+    {
+        frameStatisticsHud->Draw(dc, GetPangoContext());
+    }
 }
 
 void Lv2cWindow::OnIdle()
@@ -439,22 +529,30 @@ void Lv2cWindow::OnIdle()
 }
 void Lv2cWindow::Layout()
 {
-    Lv2cSize t = nativeWindow->Size();
+    Lv2cSize t = headlessWindow ? headlessWindow->Size() : nativeWindow->Size();
 
     Lv2cSize size{
         t.Width() / windowScale,
         t.Height() / windowScale};
     if (this->rootElement)
     {
-        cairo_surface_t *surface = nativeWindow->GetSurface();
-        Lv2cDrawingContext context(surface);
+        Lv2cDrawingContext context(NativeSurface());
+        auto measureStart = std::chrono::steady_clock::now();
+        if (currentFrame.layoutStart == Lv2cFrameRecord::time_point())
+        {
+            currentFrame.layoutStart = measureStart;
+        }
         rootElement->Measure(size, size, context);
+        auto arrangeStart = std::chrono::steady_clock::now();
         rootElement->Arrange(size, context);
 
         Lv2cRectangle clientRect = Lv2cRectangle(0, 0, size.Width(), size.Height());
         rootElement->Layout(clientRect);
         rootElement->FinalizeLayout(clientRect, clientRect);
         rootElement->OnLayoutComplete();
+        auto arrangeEnd = std::chrono::steady_clock::now();
+        frameTimings.measure += arrangeStart - measureStart;
+        frameTimings.arrange += arrangeEnd - arrangeStart;
     }
     OnLayoutComplete();
 }
@@ -470,7 +568,90 @@ void Lv2cWindow::Idle()
         this->valid = true;
         Draw();
     }
+    surfacePool->Trim();
     OnIdle();
+    EndFrame();
+}
+
+void Lv2cWindow::EndFrame()
+{
+    if (currentFrame.start == Lv2cFrameRecord::time_point())
+    {
+        return;
+    }
+    currentFrame.end = std::chrono::steady_clock::now();
+    currentFrame.timings = frameTimings;
+
+    Lv2cFrameCounts &counts = currentFrame.counts;
+    counts.elementsMeasured = gWorkCounters.elementsMeasured - frameStartCounters.elementsMeasured;
+    counts.elementsDrawn = gWorkCounters.elementsDrawn - frameStartCounters.elementsDrawn;
+    counts.styleLookups = gWorkCounters.styleLookups - frameStartCounters.styleLookups;
+    counts.surfacesAllocated = gWorkCounters.surfacesAllocated - frameStartCounters.surfacesAllocated;
+    frameCounts = counts;
+
+    if (frameTraceActive)
+    {
+        frameTrace->Add(currentFrame);
+    }
+    if (frameStatisticsHud)
+    {
+        frameStatisticsHud->AddFrame(currentFrame);
+        Invalidate(frameStatisticsHud->Bounds());
+    }
+    currentFrame.start = Lv2cFrameRecord::time_point();
+}
+
+void Lv2cWindow::StartFrameTrace(size_t maxFrames)
+{
+    frameTrace = std::make_unique<Lv2cFrameTrace>(maxFrames);
+    frameTraceActive = true;
+}
+
+void Lv2cWindow::StopFrameTrace()
+{
+    frameTraceActive = false;
+}
+
+void Lv2cWindow::WriteFrameTrace(std::ostream &s) const
+{
+    if (frameTrace)
+    {
+        frameTrace->Write(s);
+    }
+    else
+    {
+        Lv2cFrameTrace(1).Write(s);
+    }
+}
+
+void Lv2cWindow::WriteFrameTrace(const std::filesystem::path &path) const
+{
+    if (frameTrace)
+    {
+        frameTrace->Write(path);
+    }
+    else
+    {
+        Lv2cFrameTrace(1).Write(path);
+    }
+}
+
+Lv2cWindow &Lv2cWindow::ShowFrameStatistics(bool show)
+{
+    if (show != ShowFrameStatistics())
+    {
+        if (show)
+        {
+            frameStatisticsHud = std::make_unique<Lv2cFrameStatisticsHud>();
+            Invalidate(frameStatisticsHud->Bounds());
+        }
+        else
+        {
+            Invalidate(frameStatisticsHud->Bounds());
+            frameStatisticsHud = nullptr;
+        }
+    }
+    return *this;
 }
 
 void Lv2cWindow::InvalidateLayout()
@@ -560,10 +741,10 @@ void Lv2cWindow::releaseFocus(Lv2cElement *element)
 
 bool Lv2cWindow::Capture(Lv2cElement *element)
 {
-    if (nativeWindow == nullptr)
+    if (nativeWindow == nullptr && headlessWindow == nullptr)
         return false;
 
-    if (!nativeWindow->GrabPointer())
+    if (nativeWindow && !nativeWindow->GrabPointer())
     {
         LogWarning("Failed to grab pointer");
         return false;
@@ -585,7 +766,10 @@ void Lv2cWindow::releaseCapture(Lv2cElement *element)
     if (this->captureElement && this->captureElement == element)
     {
         this->captureElement = nullptr;
-        nativeWindow->UngrabPointer();
+        if (nativeWindow)
+        {
+            nativeWindow->UngrabPointer();
+        }
         if (this->GetRootElement() != nullptr)
         {
             GetRootElement()->UpdateMouseOver(lastMouseEventArgs.screenPoint);
@@ -621,6 +805,10 @@ PangoContext *Lv2cWindow::GetPangoContext()
     {
         return this->nativeWindow->GetPangoContext();
     }
+    if (this->headlessWindow)
+    {
+        return this->headlessWindow->GetPangoContext();
+    }
     return nullptr;
 }
 
@@ -629,7 +817,13 @@ void Lv2cWindow::Animate()
 
     // keep *this alive for the duration of the call.
     auto safetyPtr = this->shared_from_this();
-    auto now = animation_clock_t::now();
+    auto now = Now();
+
+    frameTimings = Lv2cFrameTimings();
+    auto animateStart = std::chrono::steady_clock::now();
+    currentFrame = Lv2cFrameRecord();
+    currentFrame.start = animateStart;
+    frameStartCounters = gWorkCounters;
 
     std::vector<AnimationCallback> callbacks;
 
@@ -691,13 +885,23 @@ void Lv2cWindow::Animate()
             }
         }
     }
+    frameTimings.animate = std::chrono::steady_clock::now() - animateStart;
+}
+
+animation_clock_time_point_t Lv2cWindow::Now() const
+{
+    if (headlessWindow)
+    {
+        return headlessWindow->Now();
+    }
+    return animation_clock_t::now();
 }
 
 AnimationHandle Lv2cWindow::PostDelayed(std::chrono::milliseconds delay, const DelayCallback &callback)
 {
     AnimationHandle h = AnimationHandle::Next();
     auto delayRecord = DelayRecord{
-        animation_clock_t::now() + std::chrono::duration_cast<animation_clock_t::duration>(delay),
+        Now() + std::chrono::duration_cast<animation_clock_t::duration>(delay),
         callback};
     {
         std::lock_guard guard{delayCallbacksMutex};
@@ -709,7 +913,7 @@ AnimationHandle Lv2cWindow::PostDelayed(std::chrono::milliseconds delay, DelayCa
 {
     AnimationHandle h = AnimationHandle::Next();
     auto delayRecord = DelayRecord{
-        animation_clock_t::now() + duration_cast<animation_clock_t::duration>(delay),
+        Now() + duration_cast<animation_clock_t::duration>(delay),
         std::move(callback)};
     {
         std::lock_guard guard{delayCallbacksMutex};
@@ -852,6 +1056,12 @@ bool Lv2cWindow::OnX11KeycodeUp(Lv2cKeyboardEventArgs &eventArgs)
 
 bool Lv2cWindow::OnKeyDown(Lv2cKeyboardEventArgs &eventArgs)
 {
+    if (eventArgs.keysymValid && eventArgs.keysym == XK_F12 &&
+        eventArgs.modifierState == ModifierState::Control + ModifierState::Shift)
+    {
+        ShowFrameStatistics(!ShowFrameStatistics());
+        return true;
+    }
     if (this->focusElement)
     {
         eventArgs.target = this->focusElement;
@@ -1417,6 +1627,10 @@ void Lv2cWindow::Resize(int width, int height)
     {
         this->nativeWindow->Resize(width, height);
     }
+    else if (this->headlessWindow)
+    {
+        this->headlessWindow->Resize(width, height);
+    }
 }
 
 WindowHandle Lv2cWindow::Handle() const
@@ -0,0 +1,322 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "Lv2cX11Display.hpp"
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <sys/select.h>
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+
+using namespace lv2c;
+
+// Host idle callbacks aren't exactly periodic. Run a frame that is nearly due rather
+// than skipping to the next one.
+static constexpr Lv2cX11Display::clock_t::duration FRAME_TOLERANCE = Lv2cX11Display::FRAME_INTERVAL / 4;
+
+Lv2cX11Display *Lv2cX11Display::Acquire()
+{
+    static thread_local Lv2cX11Display instance;
+
+    if (instance.references++ == 0)
+    {
+        try
+        {
+            instance.Open();
+        }
+        catch (const std::exception &)
+        {
+            instance.references = 0;
+            throw;
+        }
+    }
+    return &instance;
+}
+
+void Lv2cX11Display::Release()
+{
+    if (--references == 0)
+    {
+        Close();
+    }
+}
+
+Lv2cX11Display::~Lv2cX11Display()
+{
+    Close();
+}
+
+void Lv2cX11Display::Open()
+{
+    if ((x11Display = XOpenDisplay(NULL)) == NULL)
+    {
+        throw std::runtime_error("Can't open X11 display");
+    }
+    xim = XOpenIM(x11Display, 0, 0, 0);
+    xInputController = XCreateIC(xim, XNInputStyle, XIMPreeditNothing | XIMStatusNothing, NULL);
+    if (xInputController == nullptr)
+    {
+        LogError("Can't create X11 input context.");
+    }
+    lastFrameTime = clock_t::time_point();
+}
+
+void Lv2cX11Display::Close()
+{
+    if (x11Display)
+    {
+        XCloseDisplay(x11Display);
+        x11Display = nullptr;
+        xim = 0;
+        xInputController = nullptr;
+    }
+    windows.clear();
+    topLevelWindows.clear();
+    deadWindows.clear();
+}
+
+void Lv2cX11Display::AddWindow(Window x11Window, Lv2cX11Window *window)
+{
+    windows[x11Window] = window;
+}
+
+void Lv2cX11Display::RemoveWindow(Window x11Window)
+{
+    windows.erase(x11Window);
+}
+
+Lv2cX11Window *Lv2cX11Display::GetWindow(Window x11Window) const
+{
+    auto f = windows.find(x11Window);
+    if (f == windows.end())
+    {
+        return nullptr;
+    }
+    return f->second;
+}
+
+void Lv2cX11Display::AddTopLevelWindow(Lv2cX11Window *window)
+{
+    topLevelWindows.push_back(window);
+}
+
+void Lv2cX11Display::RemoveTopLevelWindow(Lv2cX11Window *window)
+{
+    auto f = std::find(topLevelWindows.begin(), topLevelWindows.end(), window);
+    if (f != topLevelWindows.end())
+    {
+        topLevelWindows.erase(f);
+    }
+}
+
+bool Lv2cX11Display::IsTopLevelWindow(Lv2cX11Window *window) const
+{
+    return std::find(topLevelWindows.begin(), topLevelWindows.end(), window) != topLevelWindows.end();
+}
+
+void Lv2cX11Display::AddDeadWindow(Lv2cX11Window *window)
+{
+    if (std::find(deadWindows.begin(), deadWindows.end(), window) == deadWindows.end())
+    {
+        deadWindows.push_back(window);
+    }
+}
+
+void Lv2cX11Display::RemoveDeadWindow(Lv2cX11Window *window)
+{
+    auto f = std::find(deadWindows.begin(), deadWindows.end(), window);
+    if (f != deadWindows.end())
+    {
+        deadWindows.erase(f);
+    }
+}
+
+bool Lv2cX11Display::DeleteDeadChildren()
+{
+    bool deleted = false;
+    // Deleting a window also deletes its children, which removes them from deadWindows.
+    while (!deadWindows.empty())
+    {
+        Lv2cX11Window *window = deadWindows.back();
+        deadWindows.pop_back();
+        if (window->parent)
+        {
+            window->parent->RemoveChild(window);
+        }
+        delete window;
+        deleted = true;
+    }
+    return deleted;
+}
+
+void Lv2cX11Display::CompressEvent(XEvent &xEvent)
+{
+    switch (xEvent.type)
+    {
+    case MotionNotify:
+    {
+        // High-rate mice generate far more motion events than frames. Merge runs of
+        // queued motion events for the same window, keeping the latest.
+        Lv2cX11Window *window = GetWindow(xEvent.xmotion.window);
+        if (!window || window->WantsAllMouseMotion(xEvent.xmotion.window))
+        {
+            break;
+        }
+        XEvent next;
+        while (XEventsQueued(x11Display, QueuedAlready) > 0)
+        {
+            XPeekEvent(x11Display, &next);
+            if (next.type != MotionNotify || next.xmotion.window != xEvent.xmotion.window)
+            {
+                break;
+            }
+            XNextEvent(x11Display, &xEvent);
+        }
+        break;
+    }
+    case ConfigureNotify:
+    {
+        // Only the most recent configuration of a window matters.
+        XEvent next;
+        while (XCheckTypedWindowEvent(x11Display, xEvent.xconfigure.window, ConfigureNotify, &next))
+        {
+            xEvent = next;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void Lv2cX11Display::DispatchEvent(XEvent &xEvent)
+{
+    Lv2cX11Window *window = GetWindow(xEvent.xany.window);
+    if (!window)
+    {
+        return;
+    }
+    // Top-level windows handle events for their child windows.
+    while (window->parent)
+    {
+        window = window->parent;
+    }
+    window->ProcessEvent(xEvent);
+}
+
+void Lv2cX11Display::RunFrame()
+{
+    lastFrameTime = clock_t::now();
+
+    std::vector<Lv2cX11Window *> t = topLevelWindows;
+    for (Lv2cX11Window *window : t)
+    {
+        if (IsTopLevelWindow(window) && !window->Quitting())
+        {
+            window->FireDeferredConfigurationChanges();
+            window->CheckForRestoreFocus();
+            window->Animate();
+            window->OnIdle();
+        }
+    }
+}
+
+bool Lv2cX11Display::ProcessEvents()
+{
+    if (!x11Display)
+    {
+        return false;
+    }
+    // Event handlers may close windows; keep the connection open until we're done.
+    ++references;
+
+    bool processedAnyMessage = DeleteDeadChildren();
+
+    XEvent xEvent;
+    while (XPending(x11Display))
+    {
+        XNextEvent(x11Display, &xEvent);
+        CompressEvent(xEvent);
+        DispatchEvent(xEvent);
+        processedAnyMessage = true;
+    }
+    if (DeleteDeadChildren())
+    {
+        processedAnyMessage = true;
+    }
+
+    if (clock_t::now() - lastFrameTime >= FRAME_INTERVAL - FRAME_TOLERANCE)
+    {
+        RunFrame();
+    }
+    XFlush(x11Display);
+
+    Release();
+    return processedAnyMessage;
+}
+
+bool Lv2cX11Display::AnimationLoop(Lv2cX11Window *window)
+{
+    while (true)
+    {
+        clock_t::duration timeToNextFrame = (lastFrameTime + FRAME_INTERVAL) - clock_t::now();
+        if (timeToNextFrame > clock_t::duration::zero())
+        {
+            WaitForEvent(timeToNextFrame);
+        }
+        ProcessEvents();
+        if (window->Quitting())
+        {
+            return true;
+        }
+    }
+}
+
+bool Lv2cX11Display::WaitForEvent(clock_t::duration timeout)
+{
+    using namespace std::chrono;
+
+    auto microseconds = duration_cast<std::chrono::microseconds>(timeout).count();
+    if (microseconds <= 0)
+    {
+        microseconds = 1;
+    }
+
+    int x11_fd = ConnectionNumber(x11Display);
+    fd_set in_fds;
+    FD_ZERO(&in_fds);
+    FD_SET(x11_fd, &in_fds);
+
+    struct timeval tv;
+    tv.tv_usec = microseconds % 1000000;
+    tv.tv_sec = microseconds / 1000000;
+
+    int num_ready_fds = select(x11_fd + 1, &in_fds, NULL, NULL, &tv);
+    if (num_ready_fds < 0)
+    {
+        if (errno == EINTR)
+        {
+            return false;
+        }
+        throw std::runtime_error("Animation loop select failed.");
+    }
+    return num_ready_fds != 0;
+}
@@ -0,0 +1,105 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "Lv2cX11Window.hpp"
+#include <unordered_map>
+#include <vector>
+#include <chrono>
+
+namespace lv2c
+{
+    /// @brief The X11 connection and event loop shared by all native windows on a thread.
+    ///
+    /// All Lv2cX11Windows created on a thread share one X connection and one input context.
+    /// Events are dispatched by X window id, and all top-level windows are animated and
+    /// drawn from a single frame clock, no matter which window's idle callback pumps the queue.
+    ///
+    /// Xlib connections are not thread-safe, so the connection is shared per thread rather
+    /// than per process. LV2 hosts run all plugin UIs on one thread, so in practice there is
+    /// one connection per host process.
+    class Lv2cX11Display
+    {
+    public:
+        using clock_t = std::chrono::steady_clock;
+
+        static constexpr int FRAME_RATE = 60;
+        static constexpr clock_t::duration FRAME_INTERVAL =
+            std::chrono::duration_cast<clock_t::duration>(std::chrono::microseconds(1000000 / FRAME_RATE));
+
+        ~Lv2cX11Display();
+
+        /// @brief Get the display for the current thread, opening the X connection if necessary.
+        /// Each call must be balanced by a call to Release().
+        static Lv2cX11Display *Acquire();
+        /// @brief Release a reference. The X connection is closed when the last reference is released.
+        void Release();
+
+        Display *XDisplay() const { return x11Display; }
+        XIC InputContext() const { return xInputController; }
+
+        void AddWindow(Window x11Window, Lv2cX11Window *window);
+        void RemoveWindow(Window x11Window);
+        Lv2cX11Window *GetWindow(Window x11Window) const;
+
+        void AddTopLevelWindow(Lv2cX11Window *window);
+        void RemoveTopLevelWindow(Lv2cX11Window *window);
+
+        /// @brief Schedule a child window that is quitting for deletion.
+        void AddDeadWindow(Lv2cX11Window *window);
+        void RemoveDeadWindow(Lv2cX11Window *window);
+
+        /// @brief Dispatch all pending events, and run a frame for every window if one is due.
+        /// @return True if any events were processed.
+        bool ProcessEvents();
+
+        /// @brief Process events until the window is quitting.
+        bool AnimationLoop(Lv2cX11Window *window);
+
+        /// @brief Wait for an X event.
+        /// @return False if the timeout expired.
+        bool WaitForEvent(clock_t::duration timeout);
+
+    private:
+        Lv2cX11Display() = default;
+        Lv2cX11Display(const Lv2cX11Display &) = delete;
+        Lv2cX11Display &operator=(const Lv2cX11Display &) = delete;
+
+        void Open();
+        void Close();
+
+        bool IsTopLevelWindow(Lv2cX11Window *window) const;
+        bool DeleteDeadChildren();
+        void CompressEvent(XEvent &xEvent);
+        void DispatchEvent(XEvent &xEvent);
+        void RunFrame();
+
+        size_t references = 0;
+        Display *x11Display = nullptr;
+        XIM xim = 0;
+        XIC xInputController = nullptr;
+
+        std::unordered_map<Window, Lv2cX11Window *> windows;
+        std::vector<Lv2cX11Window *> topLevelWindows;
+        std::vector<Lv2cX11Window *> deadWindows;
+        clock_t::time_point lastFrameTime;
+    };
+}
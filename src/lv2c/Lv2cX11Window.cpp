@@ -18,6 +18,7 @@
 // CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "Lv2cX11Window.hpp"
+#include "Lv2cX11Display.hpp"
 #include <X11/Xlib.h>
 #include <X11/Xatom.h>
 #include <X11/Xutil.h>
@@ -37,9 +38,6 @@ using namespace lv2c;
 
 static constexpr bool DEBUG_INTERCEPT_X_ERROR_HANDLER = false;
 
-static constexpr int ANIMATION_RATE = 60;
-static constexpr std::chrono::steady_clock::duration ANIMATION_DELAY = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::microseconds(1000000 / ANIMATION_RATE));
-
 
 void Lv2cX11Window::logDebug(Window x11Window, const std::string &message)
 {
@@ -286,6 +284,8 @@ inline void Lv2cX11Window::SetProperty(
 
 Lv2cX11Window::~Lv2cX11Window()
 {
+    // Child windows are registered with the shared display, so they must not outlive their parent.
+    DeleteAllChildren();
     DestroyWindowAndSurface();
 }
 
@@ -297,33 +297,23 @@ PangoContext *Lv2cX11Window::GetPangoContext()
 bool Lv2cX11Window::PostQuit()
 {
     this->quitting = true;
+    if (this->parent && sharedDisplay)
+    {
+        sharedDisplay->AddDeadWindow(this);
+    }
     return true;
 }
 
 bool Lv2cX11Window::PostQuit(Window x11Window)
 {
-    if (this->x11Window == x11Window)
-    {
-        this->quitting = true;
-
-        // destroy children.
-        while (childWindows.size() != 0)
-        {
-            auto child = childWindows[childWindows.size() - 1];
-            childWindows.pop_back();
-            delete child;
-        }
-
-        return true;
-    }
-    for (auto child : childWindows)
+    Lv2cX11Window *child = GetChild(x11Window);
+    if (!child)
     {
-        if (child->PostQuit(x11Window))
-        {
-            return true;
-        }
+        return false;
     }
-    return false;
+    child->PostQuit();
+    child->DeleteAllChildren();
+    return true;
 }
 
 bool Lv2cX11Window::Quitting() const
@@ -412,7 +402,6 @@ Lv2cX11Window::Lv2cX11Window(
     SetErrorHandler();
     CreateWindow(
         parentNativeWindow->x11Window,
-        parentNativeWindow->x11Display,
         parameters);
     parentNativeWindow->childWindows.push_back(this);
 
@@ -432,7 +421,6 @@ Lv2cX11Window::Lv2cX11Window(
     Window parentWindow = (Window)hWindow.getHandle();
     CreateWindow(
         parentWindow,
-        nullptr,
         parameters);
 
     if (parameters.owner)
@@ -440,6 +428,10 @@ Lv2cX11Window::Lv2cX11Window(
         parameters.owner->nativeWindow->childWindows.push_back(this);
         this->parent = parameters.owner->nativeWindow;
     }
+    else
+    {
+        sharedDisplay->AddTopLevelWindow(this);
+    }
     CreateSurface(size.Width(), size.Height());
     Sync();
     ReleaseErrorHandler();
@@ -471,7 +463,11 @@ void Lv2cX11Window::DestroyWindowAndSurface()
 
     if (x11Window)
     {
-        XDestroyWindow(x11Display, x11Window);
+        sharedDisplay->RemoveWindow(x11Window);
+        if (!x11WindowDestroyed)
+        {
+            XDestroyWindow(x11Display, x11Window);
+        }
 
         x11Window = 0;
         x11ParentWindow = 0;
@@ -479,30 +475,20 @@ void Lv2cX11Window::DestroyWindowAndSurface()
     }
     if (this->parent == nullptr)
     {
-        // if (xInputController)
-        // {
-        //     XDestroyIC(xInputController);
-        //     xInputController = nullptr;
-        // }
-
-        // if (xim)
-        // {
-        //     XCloseIM(xim);
-        //     xim = 0;
-        // }
-
-        if (x11Display)
-        {
-            XCloseDisplay(x11Display);
-            x11Display = nullptr;
-            x11Window = 0;
-        }
         if (this->xClassHint)
         {
             XFree((XClassHint *)this->xClassHint);
             this->xClassHint = nullptr;
         }
     }
+    if (sharedDisplay)
+    {
+        sharedDisplay->RemoveTopLevelWindow(this);
+        sharedDisplay->RemoveDeadWindow(this);
+        sharedDisplay->Release();
+        sharedDisplay = nullptr;
+        x11Display = nullptr;
+    }
     if (sizeHints != nullptr)
     {
         XFree(sizeHints);
@@ -628,32 +614,10 @@ Window Lv2cX11Window::GetOwnerFrameWindow(Display *x11Display,Window win)
 
 void Lv2cX11Window::CreateWindow(
     Window parentWindow,
-    Display *display,
     Lv2cCreateWindowParameters &parameters)
 {
-    if (display)
-    {
-        x11Display = display;
-    }
-    else if (parameters.owner != nullptr)
-    {
-        x11Display = parameters.owner->nativeWindow->x11Display;
-    }
-    else
-    {
-        if ((x11Display = XOpenDisplay(NULL)) == NULL)
-        {
-            std::runtime_error("Can't open X11 display");
-        }
-        xim = XOpenIM(x11Display, 0, 0, 0);
-        xInputController = XCreateIC(xim, XNInputStyle, XIMPreeditNothing | XIMStatusNothing, NULL);
-        if (xInputController == nullptr)
-        {
-            std::runtime_error("Can't create X11 input context.");
-        }
-
-        LOG_TRACE(0, "Created x11Display");
-    }
+    sharedDisplay = Lv2cX11Display::Acquire();
+    x11Display = sharedDisplay->XDisplay();
 
     this->xAtoms = std::make_unique<XAtoms>(x11Display);
 
@@ -723,6 +687,7 @@ void Lv2cX11Window::CreateWindow(
         sizeHints->base_width, sizeHints->base_height,
         0,backgroundPixel,borderPixel
     );
+    sharedDisplay->AddWindow(x11Window, this);
     auto event_mask =
         ExposureMask | KeyPressMask | KeyReleaseMask | VisibilityChangeMask | PointerMotionMask | EnterWindowMask |
         LeaveWindowMask | KeymapStateMask |
@@ -831,50 +796,11 @@ void Lv2cX11Window::OnIdle()
 
 bool Lv2cX11Window::AnimationLoop()
 {
-    using namespace std::chrono;
-    fd_set in_fds;
-    struct timeval tv;
-
-    // Main loop
-    while (1)
-    {
-        clock_t::time_point now = clock_t::now();
-
-        clock_t::duration timeToNextAnimation = (lastAnimationFrameTime + ANIMATION_DELAY) - now;
-        auto microseconds = duration_cast<std::chrono::microseconds>(timeToNextAnimation).count();
-        if (microseconds > 0)
-        {
-
-            // Create a File Description Set containing x11_fd
-            FD_ZERO(&in_fds);
-            int maxFd = 0;
-            AddFileDescriptors(maxFd, in_fds);
-
-            tv.tv_usec = microseconds % 1000000;
-            tv.tv_sec = microseconds / 1000000;
-
-            // Wait for X Event or a Timer
-            int num_ready_fds = select(maxFd, &in_fds, NULL, NULL, &tv);
-            if (num_ready_fds < 0)
-            {
-                throw std::runtime_error("Animation loop select failed.");
-            }
-        }
-
-        ProcessEvents();
-        if (quitting)
-        {
-            return true;
-        }
-    }
+    return sharedDisplay->AnimationLoop(this);
 }
 
 void Lv2cX11Window::Animate()
 {
-
-    using namespace std::chrono;
-    auto now = clock_t::now();
-
     auto t = this->childWindows;
     for (auto child : t)
     {
@@ -884,7 +810,6 @@ void Lv2cX11Window::Animate()
     {
         cairoWindow->Animate();
     }
-    lastAnimationFrameTime = now;
 }
 
 void Lv2cX11Window::DeleteAllChildren()
@@ -896,60 +821,18 @@ void Lv2cX11Window::DeleteAllChildren()
         delete t[i];
     }
 }
-bool Lv2cX11Window::DeleteDeadChildren()
+void Lv2cX11Window::RemoveChild(Lv2cX11Window *child)
 {
-    bool deleted = false;
-    for (size_t i = 0; i < childWindows.size(); ++i)
+    auto f = std::find(childWindows.begin(), childWindows.end(), child);
+    if (f != childWindows.end())
     {
-        Lv2cX11Window *childWindow = childWindows[i];
-
-        deleted |= childWindow->DeleteDeadChildren();
-
-        if (childWindow->Quitting())
-        {
-            childWindow->DeleteAllChildren();
-            childWindows.erase(childWindows.begin() + i);
-            --i;
-            delete childWindow;
-            deleted = true;
-        }
+        childWindows.erase(f);
     }
-    return deleted;
 }
 
 bool Lv2cX11Window::ProcessEvents()
 {
-
-    XEvent xEvent;
-
-    bool processedAnyMessage = false;
-    for (;;)
-    {
-
-        if (DeleteDeadChildren())
-        {
-            processedAnyMessage = true;
-        }
-
-        Display *display = this->x11Display;
-
-        bool pendingEvent = XPending(display);
-        if (!pendingEvent)
-        {
-            CheckForRestoreFocus();
-            Animate();
-            OnIdle();
-            XFlush(x11Display);
-            return processedAnyMessage;
-        }
-        else
-        {
-            XNextEvent(display, &xEvent);
-
-            ProcessEvent(xEvent);
-            processedAnyMessage = true;
-        }
-    }
+    return sharedDisplay->ProcessEvents();
 }
 
 void Lv2cX11Window::ProcessEvent(XEvent &xEvent)
@@ -1111,7 +994,8 @@ void Lv2cX11Window::ProcessEvent(XEvent &xEvent)
                 child->size = size;
                 cairo_xlib_surface_set_size(child->cairoSurface, size.Width(), size.Height());
             }
-            child->FireConfigurationChanged();
+            // Resize drags generate a storm of ConfigureNotify events. Notify once per frame.
+            child->configurationChanged = true;
         }
     }
     break;
@@ -1123,6 +1007,11 @@ void Lv2cX11Window::ProcessEvent(XEvent &xEvent)
     case DestroyNotify:
     {
         LOG_TRACE(xEvent.xdestroywindow.window, "DestroyNotify");
+        Lv2cX11Window *child = GetChild(xEvent.xdestroywindow.window);
+        if (child)
+        {
+            child->x11WindowDestroyed = true;
+        }
         EraseChild(xEvent.xdestroywindow.window);
         break;
     }
@@ -1183,7 +1072,7 @@ void Lv2cX11Window::ProcessEvent(XEvent &xEvent)
             window->OnX11KeycodeDown(eventArgs);
         }
 
-        int rc = Xutf8LookupString(xInputController, &xEvent.xkey, keybuf, sizeof(keybuf), &keySym, &returnStatus);
+        int rc = Xutf8LookupString(sharedDisplay->InputContext(), &xEvent.xkey, keybuf, sizeof(keybuf), &keySym, &returnStatus);
         if (rc < 0)
         {
             LogError(SS("Xutf8LookupString failed. (" << rc << ")"));
@@ -1384,47 +1273,27 @@ WindowHandle Lv2cX11Window::Handle()
 {
     return WindowHandle(this->x11Window);
 }
-void Lv2cX11Window::AddFileDescriptors(int &maxFd, fd_set &fdSet)
-{
-    auto x11_fd = ConnectionNumber(x11Display);
-    FD_SET(x11_fd, &fdSet);
-    if (x11_fd + 1 > maxFd)
-    {
-        maxFd = x11_fd + 1;
-    }
-    for (auto child : childWindows)
-    {
-        child->AddFileDescriptors(maxFd, fdSet);
-    }
-}
-
 Lv2cWindow::ptr Lv2cX11Window::GetLv2cWindow(Window x11Window)
 {
-    if (x11Window == this->x11Window)
+    Lv2cX11Window *child = GetChild(x11Window);
+    if (!child)
     {
-        return this->cairoWindow;
+        return nullptr;
     }
-    for (auto child : childWindows)
-    {
-        Lv2cWindow::ptr result = child->GetLv2cWindow(x11Window);
-        if (result)
-        {
-            return result;
-        }
-    }
-    return nullptr;
+    return child->cairoWindow;
 }
 
 Lv2cX11Window *Lv2cX11Window::GetChild(Window x11Window)
 {
-    if (this->x11Window == x11Window)
+    if (!sharedDisplay)
     {
-        return this;
+        return nullptr;
     }
-    for (auto child : childWindows)
+    Lv2cX11Window *result = sharedDisplay->GetWindow(x11Window);
+    // Only windows in this window's tree.
+    for (Lv2cX11Window *ancestor = result; ancestor != nullptr; ancestor = ancestor->parent)
     {
-        Lv2cX11Window *result = child->GetChild(x11Window);
-        if (result)
+        if (ancestor == this)
         {
             return result;
         }
@@ -1596,30 +1465,20 @@ void Lv2cX11Window::Close()
 
 bool Lv2cX11Window::EraseChild(Window x11Window)
 {
-    if (this->x11Window == x11Window && this->parent == nullptr)
+    Lv2cX11Window *child = GetChild(x11Window);
+    if (!child)
     {
-        this->quitting = true;
-        this->x11Window = 0;
-        return true;
+        return false;
     }
-    for (size_t i = 0; i < childWindows.size(); ++i)
+    if (child->parent == nullptr)
     {
-        auto child = childWindows[i];
-        if (child->x11Window == x11Window)
-        {
-            childWindows.erase(childWindows.begin() + i);
-            delete child;
-            return true;
-        }
-        else
-        {
-            if (child->EraseChild(x11Window))
-            {
-                return true;
-            }
-        }
+        // The X window is destroyed when the owning Lv2cWindow deletes us.
+        child->quitting = true;
+        return true;
     }
-    return false;
+    child->parent->RemoveChild(child);
+    delete child;
+    return true;
 }
 
 void Lv2cX11Window::FireConfigurationChanged()
@@ -1651,6 +1510,26 @@ void Lv2cX11Window::FireConfigurationChanged()
     }
 }
 
+void Lv2cX11Window::FireDeferredConfigurationChanges()
+{
+    if (configurationChanged)
+    {
+        configurationChanged = false;
+        FireConfigurationChanged();
+    }
+    auto t = this->childWindows;
+    for (auto child : t)
+    {
+        child->FireDeferredConfigurationChanges();
+    }
+}
+
+bool Lv2cX11Window::WantsAllMouseMotion(Window x11Window)
+{
+    Lv2cWindow::ptr window = GetLv2cWindow(x11Window);
+    return window && window->WantsAllMouseMotion();
+}
+
 Lv2cX11Window *Lv2cX11Window::GetTopmostDialog()
 {
     for (auto i = childWindows.rbegin(); i != childWindows.rend(); ++i)
@@ -1740,36 +1619,7 @@ void Lv2cX11Window::OnWmStateUpdated()
 
 bool Lv2cX11Window::waitForX11Event(std::chrono::milliseconds ms)
 {
-    if (this->parent != nullptr)
-    {
-        return this->parent->waitForX11Event(ms);
-    }
-    using namespace std::chrono;
-
-    auto microseconds = duration_cast<std::chrono::microseconds>(ms).count();
-    if (microseconds < 0)
-    {
-        microseconds = 1;
-    }
-
-    fd_set in_fds;
-    struct timeval tv;
-
-    // Create a File Description Set containing x11_fd
-    FD_ZERO(&in_fds);
-    int maxFd = 0;
-    AddFileDescriptors(maxFd, in_fds);
-
-    tv.tv_usec = microseconds % 1000000;
-    tv.tv_sec = microseconds / 1000000;
-
-    // Wait for X Event or a Timer
-    int num_ready_fds = select(maxFd, &in_fds, NULL, NULL, &tv);
-    if (num_ready_fds <= 0)
-    {
-        return false;
-    }
-    return true;
+    return sharedDisplay->WaitForEvent(ms);
 }
 
 void Lv2cX11Window::SetStringProperty(const std::string &key, const std::string &value)
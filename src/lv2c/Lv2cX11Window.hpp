@@ -17,6 +17,8 @@
 // IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 // CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
+#pragma once
+
 #include <cairo/cairo.h>
 #include <memory.h>
 #include <string>
@@ -43,6 +45,7 @@ typedef union _XEvent XEvent;
 
 namespace lv2c
 {
+    class Lv2cX11Display;
 
     class Lv2cX11Window
     {
@@ -175,7 +178,6 @@ namespace lv2c
 
         void CreateWindow(
             Window parentWindow, 
-            Display*display,
             Lv2cCreateWindowParameters&parameters);
 
         void CreateSurface(int w, int h);
@@ -203,14 +205,16 @@ namespace lv2c
         bool delayedFocusRestore = false;
         clock_t::time_point restoreFocusTime;
 
-        bool DeleteDeadChildren();
+        void RemoveChild(Lv2cX11Window *child);
         void DeleteAllChildren();
 
-        void AddFileDescriptors(int &maxFd, fd_set &fd);
         void FireConfigurationChanged();
+        void FireDeferredConfigurationChanges();
+        bool configurationChanged = false;
+
+        bool WantsAllMouseMotion(Window x11Window);
 
         void Animate();
-        clock_t::time_point lastAnimationFrameTime;
 
         Lv2cWindowType windowType = Lv2cWindowType::Normal;
         Atom controlMessage = 0;
@@ -229,22 +233,24 @@ namespace lv2c
         bool traceEvents = false;
         bool quitting = false;
         cairo_surface_t *cairoSurface = nullptr;
+        Lv2cX11Display *sharedDisplay = nullptr;
         Display *x11Display = nullptr;
         Window x11Window = 0;
+        /// Set when the X window was destroyed by someone else (e.g. the host destroyed our parent).
+        bool x11WindowDestroyed = false;
         Window x11ParentWindow = 0;
         Window x11RootWindow = 0;
         Window x11LogicalParentWindow = 0;
         Lv2cWindowPositioning configPositioning = Lv2cWindowPositioning::RelativeToDesktop;
 
-        XIM xim = 0;
-        XIC xInputController = nullptr;
-
         Lv2cWindow::ptr cairoWindow;
         std::string windowTitle;
         Lv2cX11Window *parent = nullptr;
         std::vector<Lv2cX11Window *> childWindows;
 
         Lv2cWindowState windowState = Lv2cWindowState::Withdrawn;
+
+        friend class Lv2cX11Display;
     };
 
     /////
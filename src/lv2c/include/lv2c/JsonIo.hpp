@@ -21,8 +21,13 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
+#include <filesystem>
 #include <iostream>
 #include <memory>
+#include <memory_resource>
+#include <deque>
+#include <vector>
 #include <cmath>
 
 #include "JsonVariant.hpp"
@@ -37,14 +42,35 @@ namespace lv2c
         json_exception(const char *message) : std::runtime_error(message) {}
     };
 
+    /// @brief Reads JSON text from a std::istream or a contiguous memory buffer.
+    ///
+    /// The istream constructor reads incrementally, consuming only the characters
+    /// of each value read, so several values can be read from one stream. 
+    /// Buffers passed as a std::string_view are parsed in place, without copying,
+    /// and must remain valid for the lifetime of the reader.
+    /// 
+    /// By default, objects and arrays in parsed json_variant trees are allocated
+    /// on the heap. If a memory resource is set, they are allocated from that resource
+    /// instead (typically a std::pmr::monotonic_buffer_resource), which must then
+    /// outlive every json_variant read from the reader.
+    ///
+    /// See also json_file_reader.
     class json_reader
     {
     public:
         json_reader(std::istream &input);
+        json_reader(std::string_view buffer);
+        virtual ~json_reader() = default;
+
+        json_reader(const json_reader &) = delete;
+        json_reader &operator=(const json_reader &) = delete;
 
         bool allowNaN() const { return allowNaN_; }
         void allowNaN(bool allow) { allowNaN_ = allow; }
 
+        std::pmr::memory_resource *memory_resource() const { return memoryResource; }
+        void memory_resource(std::pmr::memory_resource *resource) { memoryResource = resource; }
+
         void read_object_start();
         void consume(const char *str);
 
@@ -73,13 +99,43 @@ namespace lv2c
         void skip_whitespace();
         bool is_whitespace(char c);
         char get();
+        int peek_raw() { return s ? s->peek() : (p == end ? -1 : (uint8_t)*p); }
         uint16_t read_hex();
         char16_t read_u_escape();
         void consume_token(const char*token, const char*errorMessage);
+
+    protected:
+        json_reader() {}
+        void set_buffer(const char *data, size_t size) { p = data; end = data + size; }
+
     private:
 
+        friend class json_array;
+        friend class json_object;
+
+        // Scratch vectors, indexed by nesting depth, that containers are read into 
+        // so that container storage can be allocated at its final size.
+        size_t scratchDepth = 0;
+        std::deque<std::vector<json_variant>> arrayScratch;
+        std::deque<std::vector<std::pair<std::string, json_variant>>> objectScratch;
+
         bool allowNaN_ = true;
-        std::istream &s;
+        std::pmr::memory_resource *memoryResource = nullptr;
+        std::istream *s = nullptr;
+        const char *p = nullptr;
+        const char *end = nullptr;
+    };
+
+    /// @brief A json_reader that reads from a memory-mapped file.
+    class json_file_reader : public json_reader
+    {
+    public:
+        json_file_reader(const std::filesystem::path &path);
+        virtual ~json_file_reader();
+
+    private:
+        void *mappedData = nullptr;
+        size_t mappedSize = 0;
     };
 
     class json_writer
@@ -149,16 +205,26 @@ namespace lv2c
 
     inline char json_reader::get()
     {
-        int ic = s.get();
-        if (ic == -1)
+        if (s)
+        {
+            int ic = s->get();
+            if (ic == -1)
+                throw_format_error("Unexpected end of file");
+            return (char)ic;
+        }
+        if (p == end)
             throw_format_error("Unexpected end of file");
-        return (char)ic;
+        return *p++;
     }
 
     inline int json_reader::peek()
     {
+        if (!s && p != end && (uint8_t)*p > ' ' && *p != '/')
+        {
+            return (uint8_t)*p;
+        }
         skip_whitespace();
-        return s.peek();
+        return peek_raw();
     }
 
 
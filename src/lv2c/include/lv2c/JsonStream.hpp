@@ -0,0 +1,172 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "JsonIo.hpp"
+#include <vector>
+#include <string>
+
+namespace lv2c
+{
+    class json_stream_writer;
+
+    template <typename T>
+    concept JsonStreamWritable = requires(const T a, json_stream_writer &writer) {
+        {
+            a.Write(writer)
+        };
+    };
+
+    enum class json_token
+    {
+        StartObject,
+        EndObject,
+        StartArray,
+        EndArray,
+        Key,
+        String,
+        Number,
+        Bool,
+        Null,
+        EndOfInput
+    };
+
+    /// @brief Pull-style event reader over a json_reader.
+    ///
+    /// Reads a JSON document one token at a time without building a json_variant
+    /// tree. Memory use is bounded by the nesting depth of the document.
+    ///
+    /// Values that aren't needed can be skipped with skip_value(); values that are
+    /// needed in full can be materialized with read_variant().
+    class json_event_reader
+    {
+    public:
+        json_event_reader(json_reader &reader);
+
+        /// @brief Read the next token.
+        json_token next();
+
+        /// @brief The current token.
+        json_token token() const { return token_; }
+
+        /// @brief Nesting depth of the current token. The root value is at depth 0.
+        size_t depth() const { return stack.size(); }
+
+        /// @brief The value of the current Key or String token.
+        const std::string &string_value() const { return stringValue; }
+        /// @brief The value of the current Number token.
+        double number_value() const { return numberValue; }
+        /// @brief The value of the current Bool token.
+        bool bool_value() const { return boolValue; }
+
+        /// @brief Skip the next value, including all of its children.
+        void skip_value();
+
+        /// @brief Read the next value into a json_variant.
+        json_variant read_variant();
+
+    private:
+        struct frame
+        {
+            bool is_object;
+            bool first = true;
+            bool after_key = false;
+        };
+        json_token read_value_token();
+        json_variant build_variant();
+
+        json_reader &reader;
+        std::vector<frame> stack;
+        bool started = false;
+        json_token token_ = json_token::EndOfInput;
+        std::string stringValue;
+        double numberValue = 0;
+        bool boolValue = false;
+    };
+
+    /// @brief Structured streaming writer over a json_writer.
+    ///
+    /// Writes a JSON document directly to the output stream, without building
+    /// a json_variant tree. Output is formatted the same way as json_variant::write.
+    class json_stream_writer
+    {
+    public:
+        json_stream_writer(json_writer &writer);
+        json_stream_writer(std::ostream &s, bool compressed = false);
+
+        void start_object();
+        void end_object();
+        void start_array();
+        void end_array();
+
+        void key(const std::string &name);
+
+        void null_value();
+        void value(bool value);
+        void value(double value);
+        void value(const std::string &value);
+        void value(const char *value) { this->value(std::string(value)); }
+        void value(const json_variant &value);
+
+        template <typename T>
+            requires((std::is_integral_v<T> || std::is_enum_v<T>) && !std::is_same_v<T, bool>)
+        void value(T value) { this->value((double)value); }
+
+        template <JsonStreamWritable T>
+        void value(const T &value) { value.Write(*this); }
+
+        template <typename T>
+        void value(const std::vector<T> &values);
+
+        /// @brief Write a key/value pair.
+        template <typename T>
+        void member(const std::string &name, const T &value)
+        {
+            key(name);
+            this->value(value);
+        }
+
+    private:
+        struct frame
+        {
+            bool is_object;
+            bool first = true;
+        };
+        void before_value();
+
+        std::unique_ptr<json_writer> ownedWriter;
+        json_writer &writer;
+        std::vector<frame> stack;
+        bool after_key = false;
+    };
+
+    ///////////////////////////////////
+
+    template <typename T>
+    void json_stream_writer::value(const std::vector<T> &values)
+    {
+        start_array();
+        for (const auto &v : values)
+        {
+            value(v);
+        }
+        end_array();
+    }
+}
@@ -23,13 +23,16 @@
  */
 
 #pragma once
+#include <cstdint>
 #include <vector>
 #include <variant>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <type_traits>
 
 #include <string>
+#include <functional>
 #include <stdexcept>
 #include <utility>
 #include <iostream>
@@ -289,6 +292,10 @@ namespace lv2c
         static json_variant make_object();
         static json_variant make_array();
 
+        // Allocate the object or array, its control block, and its member storage from resource.
+        static json_variant make_object(std::pmr::memory_resource *resource);
+        static json_variant make_array(std::pmr::memory_resource *resource);
+
         void resize(size_t size);
         size_t size() const;
 
@@ -348,6 +355,7 @@ namespace lv2c
         using ptr = std::shared_ptr<json_array>;
 
         json_array() { ++allocation_count_; }
+        json_array(std::pmr::memory_resource *resource) : values(resource) { ++allocation_count_; }
         json_array(json_array &&other);
         ~json_array() { --allocation_count_; }
 
@@ -376,8 +384,9 @@ namespace lv2c
         {
             return allocation_count_;
         }
-        using iterator = std::vector<json_variant>::iterator;
-        using const_iterator = std::vector<json_variant>::const_iterator;
+        using values_t = std::pmr::vector<json_variant>;
+        using iterator = values_t::iterator;
+        using const_iterator = values_t::const_iterator;
 
         iterator begin() { return values.begin(); }
         iterator end() { return values.end(); }
@@ -392,7 +401,7 @@ namespace lv2c
 
         void check_index(size_t size) const;
 
-        std::vector<json_variant> values;
+        values_t values;
     };
     class json_object
     {
@@ -402,6 +411,7 @@ namespace lv2c
         using ptr = std::shared_ptr<json_object>;
 
         json_object() { ++allocation_count_; }
+        json_object(std::pmr::memory_resource *resource) : values(resource), key_index(resource) { ++allocation_count_; }
         json_object(json_object &&other);
         ~json_object() { --allocation_count_; }
 
@@ -416,7 +426,7 @@ namespace lv2c
         bool operator!=(const json_object &other) const { return (!((*this) == other)); }
         bool contains(const std::string &index) const;
 
-        using values_t = std::vector<std::pair<std::string, json_variant>>;
+        using values_t = std::pmr::vector<std::pair<std::string, json_variant>>;
         using iterator = values_t::iterator;
         using const_iterator = values_t::const_iterator;
 
@@ -434,12 +444,37 @@ namespace lv2c
             return allocation_count_;
         }
 
+        // Objects with at least this many members maintain a hash index over their keys.
+        static constexpr size_t INDEX_THRESHOLD = 16;
+        // strictly for testing purposes.
+        bool is_indexed() const { return key_index.size() != 0; }
+
         void read(json_reader &reader);
         void write(json_writer &writer) const;
 
     private:
+        // Open-addressed (linear probe) hash index over the members of values.
+        // Members stay in insertion order in values so that serialization order 
+        // is preserved; the index only accelerates lookups. Built when the object 
+        // grows to INDEX_THRESHOLD members, and maintained on insert thereafter, 
+        // so const lookups never modify the object. Keys must not be modified 
+        // through iterators.
+        struct index_entry
+        {
+            static constexpr uint32_t EMPTY = (uint32_t)-1;
+            uint32_t hash = 0;
+            uint32_t position = EMPTY;
+        };
+
+        static uint32_t hash_key(const std::string &key);
+        size_t find_position(const std::string &key) const;
+        json_variant &append(std::string &&key);
+        void index_insert(uint32_t hash, size_t position);
+        void rebuild_index(size_t capacity);
+
         static int64_t allocation_count_;
         values_t values;
+        std::pmr::vector<index_entry> key_index;
     };
 
     ////////////////////////////////////////////////
@@ -601,6 +636,14 @@ namespace lv2c
     {
         return json_variant{std::make_shared<json_array>()};
     }
+    inline /*static*/ json_variant json_variant::make_object(std::pmr::memory_resource *resource)
+    {
+        return json_variant{std::allocate_shared<json_object>(std::pmr::polymorphic_allocator<json_object>(resource), resource)};
+    }
+    inline /*static */ json_variant json_variant::make_array(std::pmr::memory_resource *resource)
+    {
+        return json_variant{std::allocate_shared<json_array>(std::pmr::polymorphic_allocator<json_array>(resource), resource)};
+    }
 
     inline void json_variant::resize(size_t size)
     {
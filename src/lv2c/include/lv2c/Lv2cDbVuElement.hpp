@@ -18,10 +18,10 @@
 // CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #pragma once
-#include <chrono>
 #include "Lv2cVuElement.hpp"
+#include "Lv2cMeterBallistics.hpp"
 namespace lv2c {
-    class Lv2cDbVuElement: public Lv2cVuElement {
+    class Lv2cDbVuElement: public Lv2cVuElement, private Lv2cMeterBallisticsClient {
     public:
         using self = Lv2cDbVuElement;
         using super = Lv2cVuElement;
@@ -41,13 +41,7 @@ namespace lv2c {
 
     protected:
         double ValueToClient(double value, const Lv2cRectangle&vuRectangle);
-        using clock_t = std::chrono::steady_clock;
-        AnimationHandle animationHandle;
-        clock_t::time_point animationStartTime;
-        double animationStartValue = 0;
-        void AnimationTick(const animation_clock_time_point_t&now);
-        void StopAnimation();
-        void StartAnimation(bool hold);
+
         BINDING_PROPERTY(HoldValue,double,0.0)
         virtual void OnValueChanged(double value) override;
         virtual void OnMount() override;
@@ -55,9 +49,16 @@ namespace lv2c {
         virtual void UpdateStyle() override;
         virtual const Lv2cVuSettings &Settings() const override;
         virtual void OnDraw(Lv2cDrawingContext &dc) override;
+        virtual void OnMeterHoldChanged(size_t clientChannel, double holdValue) override;
     private:
         friend class Lv2cStereoDbVuElement;
 
+        void UpdateMeterRange();
+
+        Lv2cMeterBallistics::channel_id meterChannel = Lv2cMeterBallistics::INVALID_CHANNEL;
+        observer_handle_t minValueObserverHandle;
+        observer_handle_t maxValueObserverHandle;
+
         static void DrawTicks(
             Lv2cDrawingContext &dc,
             double minValue, 
@@ -78,7 +79,7 @@ namespace lv2c {
 
     };
 
-    class Lv2cStereoDbVuElement: public Lv2cStereoVuElement {
+    class Lv2cStereoDbVuElement: public Lv2cStereoVuElement, private Lv2cMeterBallisticsClient {
     public:
         using self = Lv2cStereoDbVuElement;
         using super = Lv2cStereoVuElement;
@@ -97,21 +98,6 @@ namespace lv2c {
         double MaxValue() { return MaxValueProperty.get(); }
 
     protected:
-        using clock_t = std::chrono::steady_clock;
-        AnimationHandle animationHandle;
-        clock_t::time_point leftAnimationStartTime;
-        clock_t::time_point rightAnimationStartTime;
-        double leftAnimationStartValue = 0;
-        double rightAnimationStartValue = 0;
-        bool leftAnimationActive = false;
-        bool rightAnimationActive = false;
-
-        void AnimationTick(const animation_clock_time_point_t&now);
-        void StopAnimation();
-        void StartLeftAnimation(bool hold);
-        void StartRightAnimation(bool hold);
-
-
         BINDING_PROPERTY(HoldValue,double,0.0)
         BINDING_PROPERTY(RightHoldValue,double,0.0)
         virtual void OnValueChanged(double value) override;
@@ -121,7 +107,14 @@ namespace lv2c {
         virtual void UpdateStyle() override;
         virtual const Lv2cVuSettings &Settings() const override;
         virtual void OnDraw(Lv2cDrawingContext &dc) override;
+        virtual void OnMeterHoldChanged(size_t clientChannel, double holdValue) override;
+    private:
+        void UpdateMeterRange();
 
+        Lv2cMeterBallistics::channel_id leftMeterChannel = Lv2cMeterBallistics::INVALID_CHANNEL;
+        Lv2cMeterBallistics::channel_id rightMeterChannel = Lv2cMeterBallistics::INVALID_CHANNEL;
+        observer_handle_t minValueObserverHandle;
+        observer_handle_t maxValueObserverHandle;
     };
 
 }
\ No newline at end of file
@@ -58,6 +58,17 @@ namespace lv2c
 
         BINDING_PROPERTY(TintImage,bool,true)
 
+        /// @brief Half-width of the dial's indicator, as a fraction of the dial radius.
+        ///
+        /// Determines the area that is redrawn when the value changes. The rest of the dial
+        /// image is assumed to be rotationally symmetric. Only set a non-zero value for
+        /// artwork where that is true. 
+        ///
+        /// Zero (the default) uses the geometry of the built-in "fx_dial.svg" while Source 
+        /// is "fx_dial.svg", and otherwise redraws the entire dial on each value change.
+        /// A negative value always redraws the entire dial.
+        BINDING_PROPERTY(IndicatorWidth,double,0.0)
+
         Lv2cDialElement& Value(double value) { 
             ValueProperty.set(value); 
             return *this;
@@ -75,7 +86,9 @@ namespace lv2c
 
 
         virtual void OnValueChanged(double value) override;
+        virtual Lv2cRectangle ValueDirtyRect(double oldValue, double newValue) override;
     private:
+        double displayedValue = 0;
         Lv2cDropShadowElement::ptr dropShadow;
         Lv2cSvgElement::ptr image;
     };
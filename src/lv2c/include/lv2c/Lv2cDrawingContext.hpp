@@ -306,6 +306,39 @@ namespace lv2c
         cairo_pattern_t *pattern = nullptr;
     };
 
+    /// @brief An owned copy of a path, which can be appended to a context repeatedly.
+    class Lv2cPath
+    {
+    public:
+        Lv2cPath() : path(nullptr) {}
+        Lv2cPath(cairo_path_t *path) : path(path) {}
+        Lv2cPath(Lv2cPath &&other) : path(nullptr) { std::swap(this->path, other.path); }
+        Lv2cPath(const Lv2cPath &other) = delete;
+        ~Lv2cPath() { release(); }
+
+        Lv2cPath &operator=(Lv2cPath &&other)
+        {
+            std::swap(this->path, other.path);
+            return *this;
+        }
+        Lv2cPath &operator=(const Lv2cPath &other) = delete;
+
+        cairo_path_t *get() const { return path; }
+        operator bool() const { return path != nullptr; }
+
+        void release()
+        {
+            if (path)
+            {
+                cairo_path_destroy(path);
+                path = nullptr;
+            }
+        }
+
+    private:
+        cairo_path_t *path;
+    };
+
     class Lv2cRectangleList
     {
     public:
@@ -531,6 +564,9 @@ namespace lv2c
         }
         void close_path() { cairo_close_path(context); }
 
+        Lv2cPath copy_path() { return Lv2cPath(cairo_copy_path(context)); }
+        void append_path(const Lv2cPath &path) { cairo_append_path(context, path.get()); }
+
         void paint() { cairo_paint(context); }
         void paint_with_alpha(double alpha) { cairo_paint_with_alpha(context, alpha); }
 
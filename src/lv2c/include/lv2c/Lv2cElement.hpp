@@ -125,6 +125,10 @@ namespace lv2c
 
         virtual bool isContainer() const { return false; }
         virtual bool WantsFocus() const;
+        /// @brief Receive every mouse motion event while this element has mouse capture.
+        /// By default, queued motion events are coalesced so that only the latest position is delivered.
+        /// Override for drawing-style controls that need every sample.
+        virtual bool WantsAllMouseMotion() const;
         const Lv2cRectangle & ScreenBounds() const;
         const Lv2cRectangle & ScreenBorderRect() const;
         const Lv2cRectangle & ScreenClientBounds() const;
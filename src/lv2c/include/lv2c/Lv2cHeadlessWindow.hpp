@@ -0,0 +1,122 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "Lv2cWindow.hpp"
+#include "Lv2cDrawingContext.hpp"
+#include <chrono>
+#include <filesystem>
+#include <string>
+
+namespace lv2c
+{
+    /// @brief Offscreen native-window backend for Lv2cWindow.
+    ///
+    /// Runs the same layout, draw and animation pipeline as an X11 window, but renders
+    /// into an image surface, and requires no display connection. Nothing happens
+    /// on its own: time only advances when AdvanceTime() is called, frames are only
+    /// rendered when RenderFrame() is called, and input only arrives through the
+    /// synthetic event methods. Rendering and animation are therefore deterministic,
+    /// which makes headless windows suitable for tests, thumbnails and benchmarks.
+    ///
+    /// Create with Lv2cWindow::CreateHeadlessWindow(). The Lv2cWindow owns the
+    /// headless window.
+    ///
+    /// Input coordinates are in window coordinates (before WindowScale() is applied).
+    class Lv2cHeadlessWindow
+    {
+    public:
+        /// @brief The interval between frames used by Run().
+        static constexpr animation_clock_t::duration FRAME_INTERVAL =
+            std::chrono::duration_cast<animation_clock_t::duration>(std::chrono::microseconds(1000000 / 60));
+
+        Lv2cHeadlessWindow(const Lv2cHeadlessWindow &) = delete;
+        Lv2cHeadlessWindow &operator=(const Lv2cHeadlessWindow &) = delete;
+        ~Lv2cHeadlessWindow();
+
+        Lv2cWindow &Window() { return *window; }
+
+        /// @brief Size of the surface in device pixels.
+        Lv2cSize Size() const { return size; }
+        /// @brief Resize the surface.
+        /// @param width Width in device pixels.
+        /// @param height Height in device pixels.
+        void Resize(int width, int height);
+
+        /// @brief The surface that the window renders into.
+        /// Valid after RenderFrame() has been called.
+        Lv2cImageSurface &Surface() { return surface; }
+
+        /// @brief Write the current contents of the surface to a PNG file.
+        void WritePng(const std::filesystem::path &path);
+
+        PangoContext *GetPangoContext() { return pangoContext; }
+
+        /// @brief The current time of the synthetic animation clock.
+        animation_clock_time_point_t Now() const { return now; }
+        /// @brief Advance the synthetic animation clock.
+        void AdvanceTime(animation_clock_t::duration time);
+
+        /// @brief Render a frame at the current time.
+        /// Runs animation callbacks, and delayed callbacks that have come due, then
+        /// performs layout and draws damaged areas of the window.
+        void RenderFrame();
+        /// @brief Advance time by FRAME_INTERVAL steps, rendering a frame at each step.
+        /// @param time The total amount of time to advance.
+        void Run(animation_clock_t::duration time);
+
+        void MouseMove(Lv2cPoint point, ModifierState modifierState = ModifierState::Empty);
+        void MouseDown(Lv2cPoint point, uint64_t button = 1, ModifierState modifierState = ModifierState::Empty);
+        void MouseUp(Lv2cPoint point, uint64_t button = 1, ModifierState modifierState = ModifierState::Empty);
+        /// @brief Move the mouse to a point, then press and release a mouse button.
+        void Click(Lv2cPoint point, uint64_t button = 1, ModifierState modifierState = ModifierState::Empty);
+        void ScrollWheel(Lv2cPoint point, Lv2cScrollDirection direction, ModifierState modifierState = ModifierState::Empty);
+        void MouseLeave();
+
+        /// @brief Send a key press for an X11 keysym.
+        /// @return True if the event was handled.
+        bool KeyDown(unsigned int keysym, ModifierState modifierState = ModifierState::Empty);
+        /// @brief Send a key press for each UTF-8 character of text.
+        void TypeText(const std::string &text, ModifierState modifierState = ModifierState::Empty);
+
+        void FocusIn();
+        void FocusOut();
+
+        void Close();
+        void PostQuit() { quitting = true; }
+        bool Quitting() const { return quitting; }
+
+    private:
+        friend class Lv2cWindow;
+        Lv2cHeadlessWindow(Lv2cWindow *window, const Lv2cCreateWindowParameters &parameters);
+
+        void CreateSurface(Lv2cSize size);
+        Lv2cPoint ToDevice(Lv2cPoint point) const;
+
+        Lv2cWindow *window;
+        Lv2cImageSurface surface;
+        PangoContext *pangoContext = nullptr;
+        Lv2cSize size;
+        animation_clock_time_point_t now;
+        bool quitting = false;
+        bool closed = false;
+    };
+}
@@ -0,0 +1,117 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <filesystem>
+#include <iosfwd>
+
+namespace lv2c
+{
+    /// @brief Running totals of work done on the current thread.
+    ///
+    /// Incremented by elements, styles, and surface allocation. Windows take the difference
+    /// across a frame to produce Lv2cFrameCounts.
+    struct Lv2cWorkCounters
+    {
+        uint64_t elementsMeasured = 0;
+        uint64_t elementsDrawn = 0;
+        uint64_t styleLookups = 0;
+        uint64_t surfacesAllocated = 0;
+    };
+
+    extern thread_local Lv2cWorkCounters gWorkCounters;
+
+    /// @brief Time spent in each phase of a frame.
+    struct Lv2cFrameTimings
+    {
+        /// @brief Animation and delayed callbacks.
+        std::chrono::nanoseconds animate{0};
+        std::chrono::nanoseconds measure{0};
+        /// @brief Arrange, Layout and FinalizeLayout.
+        std::chrono::nanoseconds arrange{0};
+        /// @brief Drawing damaged areas into an intermediate group.
+        std::chrono::nanoseconds draw{0};
+        /// @brief Compositing the intermediate group onto the window surface.
+        std::chrono::nanoseconds present{0};
+    };
+
+    /// @brief Work done during a frame.
+    struct Lv2cFrameCounts
+    {
+        /// @brief Number of damage rectangles drawn.
+        uint64_t damageRects = 0;
+        uint64_t elementsMeasured = 0;
+        /// @brief Number of elements whose OnDraw method was called.
+        uint64_t elementsDrawn = 0;
+        /// @brief Number of style property reads not satisfied by the element's own style, and
+        /// so resolved through its classes or parents.
+        uint64_t styleLookups = 0;
+        /// @brief New image surfaces, and new surface pool buffers.
+        uint64_t surfacesAllocated = 0;
+    };
+
+    /// @brief A completed frame.
+    struct Lv2cFrameRecord
+    {
+        using time_point = std::chrono::steady_clock::time_point;
+
+        time_point start;
+        /// @brief Start of the first layout pass. Default-constructed if the frame did no layout.
+        time_point layoutStart;
+        /// @brief Start of the first damage rectangle. Default-constructed if the frame drew nothing.
+        time_point drawStart;
+        time_point end;
+        Lv2cFrameTimings timings;
+        Lv2cFrameCounts counts;
+    };
+
+    /// @brief Records frames for export in Chrome trace-event format.
+    ///
+    /// The output can be loaded into chrome://tracing or ui.perfetto.dev. Each frame produces
+    /// a "frame" event with nested animate, measure, arrange, draw, and present events, and
+    /// a counter event carrying the frame's work counts.
+    class Lv2cFrameTrace
+    {
+    public:
+        /// @brief Constructor.
+        /// @param maxFrames The number of frames to retain. Older frames are discarded.
+        Lv2cFrameTrace(size_t maxFrames);
+
+        void Add(const Lv2cFrameRecord &frame);
+        /// @brief The number of frames currently retained.
+        size_t Size() const { return frames.size(); }
+        /// @brief Retained frames, oldest first.
+        const Lv2cFrameRecord &Frame(size_t index) const;
+        void Clear();
+
+        void Write(std::ostream &s) const;
+        void Write(const std::filesystem::path &path) const;
+
+    private:
+        size_t maxFrames;
+        size_t head = 0;
+        std::vector<Lv2cFrameRecord> frames;
+    };
+}
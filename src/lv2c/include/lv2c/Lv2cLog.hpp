@@ -20,6 +20,16 @@
 #pragma once
 #include <string>
 
+// Log calls above LV2C_MAX_LOG_LEVEL are compiled out of LogDebug/LogTrace and the
+// LV2C_LOG_DEBUG/LV2C_LOG_TRACE macros. Values match Lv2cLogLevel.
+#ifndef LV2C_MAX_LOG_LEVEL
+#ifdef NDEBUG
+#define LV2C_MAX_LOG_LEVEL 3
+#else
+#define LV2C_MAX_LOG_LEVEL 5
+#endif
+#endif
+
 namespace lv2c
 {
     enum class Lv2cLogLevel
@@ -28,13 +38,90 @@ namespace lv2c
         Error,
         Warning,
         Info,
-        Debug
+        Debug,
+        Trace
     };
+
+    constexpr Lv2cLogLevel COMPILED_LOG_LEVEL = (Lv2cLogLevel)LV2C_MAX_LOG_LEVEL;
+
+    /// @brief Destination for log messages.
+    ///
+    /// Sinks are called on the logging thread, never on the thread that logged the message.
+    /// A sink must be registered with AddLogSink before it is passed to Log().
+    class Lv2cLogSink
+    {
+    public:
+        virtual ~Lv2cLogSink() {}
+        virtual void Write(Lv2cLogLevel level, const char *message) = 0;
+        /// @brief Called after each batch of messages has been written.
+        virtual void Flush() {}
+    };
+
     void SetLogLevel(Lv2cLogLevel logLevel);
+    Lv2cLogLevel GetLogLevel();
+    bool LogEnabled(Lv2cLogLevel level);
+
+    /// @brief Queue a message for the logging thread.
+    ///
+    /// Messages are written asynchronously. Long messages are truncated, and
+    /// messages are dropped (and counted) if the queue is full. Repeats of the
+    /// same message from the same thread are rate-limited.
+    /// @param level The log level of the message.
+    /// @param message The message.
+    /// @param sink The sink to write to, or nullptr to use the default sink.
+    void Log(Lv2cLogLevel level, const char *message, Lv2cLogSink *sink = nullptr);
+
+    /// @brief Add a sink. The most recently added sink receives messages that don't specify a sink.
+    /// The default sink writes to std::cout.
+    void AddLogSink(Lv2cLogSink *sink);
+    /// @brief Remove a sink. Pending messages are written before the sink is removed.
+    void RemoveLogSink(Lv2cLogSink *sink);
+
+    /// @brief Wait until all queued messages have been written.
+    void FlushLog();
+
     void LogError(const std::string &message);
     void LogWarning(const std::string &message);
     void LogInfo(const std::string &message);
-    void LogDebug(const std::string &message);
 
+    inline void LogDebug(const std::string &message)
+    {
+        if constexpr (COMPILED_LOG_LEVEL >= Lv2cLogLevel::Debug)
+        {
+            Log(Lv2cLogLevel::Debug, message.c_str());
+        }
+    }
+    inline void LogTrace(const std::string &message)
+    {
+        if constexpr (COMPILED_LOG_LEVEL >= Lv2cLogLevel::Trace)
+        {
+            Log(Lv2cLogLevel::Trace, message.c_str());
+        }
+    }
+
+}
+
+// Unlike LogDebug/LogTrace, the macros don't evaluate their argument unless the message will be logged.
+#define LV2C_LOG_DEBUG(message)                                                                    \
+    do                                                                                             \
+    {                                                                                              \
+        if constexpr (::lv2c::COMPILED_LOG_LEVEL >= ::lv2c::Lv2cLogLevel::Debug)                   \
+        {                                                                                          \
+            if (::lv2c::LogEnabled(::lv2c::Lv2cLogLevel::Debug))                                   \
+            {                                                                                      \
+                ::lv2c::Log(::lv2c::Lv2cLogLevel::Debug, std::string(message).c_str());            \
+            }                                                                                      \
+        }                                                                                          \
+    } while (false)
 
-}
\ No newline at end of file
+#define LV2C_LOG_TRACE(message)                                                                    \
+    do                                                                                             \
+    {                                                                                              \
+        if constexpr (::lv2c::COMPILED_LOG_LEVEL >= ::lv2c::Lv2cLogLevel::Trace)                   \
+        {                                                                                          \
+            if (::lv2c::LogEnabled(::lv2c::Lv2cLogLevel::Trace))                                   \
+            {                                                                                      \
+                ::lv2c::Log(::lv2c::Lv2cLogLevel::Trace, std::string(message).c_str());            \
+            }                                                                                      \
+        }                                                                                          \
+    } while (false)
@@ -0,0 +1,112 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "Lv2cTypes.hpp"
+#include "Lv2cElement.hpp"
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+namespace lv2c
+{
+    class Lv2cWindow;
+
+    /// @brief Receives hold-value updates from Lv2cMeterBallistics.
+    class Lv2cMeterBallisticsClient
+    {
+    public:
+        virtual ~Lv2cMeterBallisticsClient() {}
+        /// @brief The hold value of a channel has changed.
+        /// @param clientChannel The client channel number supplied to AddChannel.
+        /// @param holdValue The new hold value.
+        virtual void OnMeterHoldChanged(size_t clientChannel, double holdValue) = 0;
+    };
+
+    /// @brief Peak-hold ballistics for all VU meters in a window.
+    ///
+    /// Meters register one channel per bar. When a channel's level rises above its
+    /// hold value, the hold value jumps to the new level, holds for HOLD_TIME, and then
+    /// falls by one full meter range per DECAY_TIME until it meets the level again.
+    ///
+    /// All channels in a window are advanced by a single animation callback. Channel state
+    /// is kept in parallel arrays so that a tick is a single pass over contiguous memory, 
+    /// regardless of how many meters a window contains.
+    class Lv2cMeterBallistics
+    {
+    public:
+        using channel_id = uint32_t;
+        static constexpr channel_id INVALID_CHANNEL = (channel_id)-1;
+
+        static constexpr std::chrono::milliseconds HOLD_TIME{2000};
+        static constexpr std::chrono::milliseconds DECAY_TIME{1000};
+
+        Lv2cMeterBallistics(Lv2cWindow *window);
+        ~Lv2cMeterBallistics();
+
+        Lv2cMeterBallistics(const Lv2cMeterBallistics &) = delete;
+        Lv2cMeterBallistics &operator=(const Lv2cMeterBallistics &) = delete;
+
+        /// @brief Register a meter channel.
+        /// @param client Receives hold value updates for the channel.
+        /// @param clientChannel Identifies the channel to the client (e.g. 0=left, 1=right).
+        /// @param value The initial level and hold value.
+        /// @param range Full-scale range of the meter (MaxValue()-MinValue()), which determines the decay rate.
+        /// @return A handle for the channel.
+        channel_id AddChannel(Lv2cMeterBallisticsClient *client, size_t clientChannel, double value, double range);
+        void RemoveChannel(channel_id channel);
+
+        /// @brief Set the full-scale range of a channel.
+        void Range(channel_id channel, double range);
+
+        /// @brief Set the current level of a channel.
+        /// @return The hold value after the update.
+        double Level(channel_id channel, double value);
+
+        double HoldValue(channel_id channel) const { return hold[channel]; }
+
+        /// @brief The number of channels whose hold values are currently held or decaying.
+        size_t ActiveChannels() const { return activeChannels; }
+
+    private:
+        void Tick(const animation_clock_time_point_t &now);
+        void RequestTick();
+        double Seconds(const animation_clock_time_point_t &time) const;
+
+        Lv2cWindow *window;
+        AnimationHandle animationHandle;
+        animation_clock_time_point_t epoch;
+        size_t activeChannels = 0;
+
+        // Per-channel state, indexed by channel_id.
+        std::vector<double> level;
+        std::vector<double> hold;
+        std::vector<double> decayStartValue;
+        std::vector<double> decayStartTime; // seconds since epoch.
+        std::vector<double> decayRate;      // units per second.
+        std::vector<uint8_t> active;        // 1 while the hold value is held or decaying.
+
+        std::vector<Lv2cMeterBallisticsClient *> clients;
+        std::vector<size_t> clientChannels;
+        std::vector<channel_id> freeChannels;
+
+        std::vector<channel_id> changedChannels;
+    };
+}
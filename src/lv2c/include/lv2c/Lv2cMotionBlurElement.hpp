@@ -39,6 +39,16 @@ namespace lv2c {
 
         void Blur(Lv2cPoint from, Lv2cPoint to) { From(from); To(to); }        
 
+        /// @brief Apply a horizontal or vertical motion blur.
+        /// @param surface The source surface (ARGB32).
+        /// @param result Receives the result. Must be ARGB32, and the same size as surface. Every pixel is written.
+        /// @param from Start of the blur, in device pixels.
+        /// @param to End of the blur, in device pixels.
+        ///
+        /// Each result pixel is the average of source pixels offset by between from and to,
+        /// summed with linear intensities. Pixels outside the source surface are treated as transparent.
+        static void MotionBlurFilter(Lv2cImageSurface &surface, Lv2cImageSurface &result, Lv2cPoint from, Lv2cPoint to);
+
     protected:
         bool WillDraw() const override;
 
@@ -48,10 +58,6 @@ namespace lv2c {
         virtual void Measure(Lv2cSize constraint, Lv2cSize maxAvailable, Lv2cDrawingContext &context) override {
             super::Measure(constraint,maxAvailable,context);
         }
-    private:
-
-        Lv2cImageSurface MotionBlurFilter(Lv2cImageSurface& surface,Lv2cPoint from, Lv2cPoint to);
-
     };
 
 
@@ -27,6 +27,11 @@
 #include "JsonVariant.hpp"
 #include <filesystem>
 #include <string>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
 #include "lv2c/Lv2cTypes.hpp"
 
 
@@ -42,16 +47,50 @@ namespace lv2c {
 
         void Load(const std::string &identifier);
 
+        /// @brief Save changes to Root().
+        /// If WriteBehindDelay() is non-zero, the file is written on a background thread
+        /// once the delay has elapsed, and updates made during the delay are coalesced 
+        /// into a single write. Otherwise the file is written immediately.
         void Update();
+
+        /// @brief Synchronously write any pending update. 
+        void Flush();
+
         json_variant &Root();
+
+        static constexpr std::chrono::milliseconds DEFAULT_WRITE_BEHIND_DELAY{1000};
+
+        std::chrono::milliseconds WriteBehindDelay() const;
+        Lv2cSettingsFile &WriteBehindDelay(std::chrono::milliseconds delay);
+
+        /// @brief Number of writes that were avoided by coalescing updates.
+        uint64_t WritesAvoided() const;
+
     private: 
+        static bool WriteFile(const std::filesystem::path &path, const std::string &value);
+        void WriterThreadProc();
+        void StopWriterThread();
+
         std::string sharedInstanceidentifier;
         std::filesystem::path GetSettingsPath(const std::string &identifier);
         std::filesystem::path filePath;
-        std::string lastValue;
         json_variant root;
         static std::map<std::string,Lv2cSettingsFile*> sharedInstances;
 
+        std::chrono::milliseconds writeBehindDelay = DEFAULT_WRITE_BEHIND_DELAY;
+
+        mutable std::mutex writeMutex;
+        std::condition_variable writeCv;
+        std::thread writerThread;
+        bool writerClosing = false;
+        bool writePending = false;
+        bool writeInProgress = false;
+        std::string pendingValue;
+        std::filesystem::path pendingPath;
+        std::string lastValue; // the last value loaded or successfully written.
+        std::chrono::steady_clock::time_point writeDeadline;
+        uint64_t writesAvoided = 0;
+
     };
 
     extern json_variant Lv2cPointToJson(Lv2cPoint value);
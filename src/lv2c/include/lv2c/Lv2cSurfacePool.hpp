@@ -0,0 +1,118 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "Lv2cDrawingContext.hpp"
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <cstddef>
+
+namespace lv2c
+{
+    /// @brief A pool of scratch image surfaces for offscreen compositing.
+    ///
+    /// Elements that render through an intermediate buffer (opacity, motion blur,
+    /// drop shadows) acquire surfaces from their window's pool instead of
+    /// allocating a fresh image surface on every paint. Buffers are bucketed by size
+    /// class, and are returned to the pool when the last reference to the surface
+    /// is released.
+    ///
+    /// The pool retains at most HighWaterMark() bytes of free buffers. Free buffers
+    /// that haven't been used for IdleTimeout() are released by Trim(), which
+    /// the window calls from its idle handler.
+    ///
+    /// Not thread-safe. Use from the UI thread only.
+    class Lv2cSurfacePool : public std::enable_shared_from_this<Lv2cSurfacePool>
+    {
+    public:
+        using self = Lv2cSurfacePool;
+        using ptr = std::shared_ptr<self>;
+        static ptr Create() { return std::make_shared<self>(); }
+
+        static constexpr size_t DEFAULT_HIGH_WATER_MARK = 32 * 1024 * 1024;
+        static constexpr std::chrono::milliseconds DEFAULT_IDLE_TIMEOUT{5000};
+
+        Lv2cSurfacePool();
+        ~Lv2cSurfacePool();
+
+        Lv2cSurfacePool(const Lv2cSurfacePool &) = delete;
+        Lv2cSurfacePool &operator=(const Lv2cSurfacePool &) = delete;
+
+        /// @brief Get an image surface from the pool.
+        /// @param format The pixel format.
+        /// @param width Width in pixels.
+        /// @param height Height in pixels.
+        /// @param clear If true, the surface is cleared to transparent black, as with a newly-created image surface.
+        /// Pass false if every pixel of the surface will be overwritten.
+        /// @return An image surface of exactly the requested size.
+        Lv2cImageSurface Acquire(cairo_format_t format, int width, int height, bool clear = true);
+
+        /// @brief Maximum number of bytes of free buffers retained by the pool.
+        size_t HighWaterMark() const { return highWaterMark; }
+        Lv2cSurfacePool &HighWaterMark(size_t bytes);
+
+        /// @brief Free buffers unused for longer than this are released by Trim().
+        std::chrono::milliseconds IdleTimeout() const { return idleTimeout; }
+        Lv2cSurfacePool &IdleTimeout(std::chrono::milliseconds timeout);
+
+        /// @brief Release free buffers that have been idle for longer than IdleTimeout().
+        void Trim();
+        /// @brief Release all free buffers.
+        void Clear();
+
+        /// @brief Bytes held in free buffers.
+        size_t FreeBytes() const { return freeBytes; }
+        /// @brief Bytes held by surfaces that are currently in use.
+        size_t BytesInUse() const { return bytesInUse; }
+        /// @brief The largest value of FreeBytes()+BytesInUse() seen so far.
+        size_t PeakBytes() const { return peakBytes; }
+        /// @brief Number of buffers allocated (as opposed to recycled) so far.
+        size_t Allocations() const { return allocations; }
+
+    private:
+        using clock_t = std::chrono::steady_clock;
+
+        struct Buffer
+        {
+            void *data = nullptr;
+            size_t size = 0;
+            clock_t::time_point lastUsed;
+        };
+        struct Lease;
+
+        static size_t SizeClass(size_t bytes);
+        static void FreeBuffer(Buffer &buffer);
+        static void OnSurfaceDestroyed(void *lease);
+        void Return(Buffer &&buffer);
+        void EvictTo(size_t maxBytes);
+
+        size_t highWaterMark = DEFAULT_HIGH_WATER_MARK;
+        std::chrono::milliseconds idleTimeout = DEFAULT_IDLE_TIMEOUT;
+        clock_t::time_point nextTrimTime;
+
+        // Free buffers, sorted by size; most recently used last within each size.
+        std::vector<Buffer> freeBuffers;
+        size_t freeBytes = 0;
+        size_t bytesInUse = 0;
+        size_t peakBytes = 0;
+        size_t allocations = 0;
+    };
+}
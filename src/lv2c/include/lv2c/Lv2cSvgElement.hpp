@@ -44,6 +44,11 @@ namespace lv2c
         Lv2cSvgElement &Rotation(double angle);
         double Rotation() const;
 
+        /// @brief Whether a change of Rotation invalidates the entire element (default true).
+        /// Owners that invalidate just the area that changes can turn this off.
+        Lv2cSvgElement &InvalidateOnRotation(bool value);
+        bool InvalidateOnRotation() const;
+
     protected:
         virtual Lv2cSize MeasureClient(Lv2cSize clientConstraint, Lv2cSize clientAvailable, Lv2cDrawingContext &context) override;
 
@@ -58,6 +63,7 @@ namespace lv2c
         void OnMount() override;
 
         bool changed = false;
+        bool invalidateOnRotation = true;
         std::shared_ptr<Lv2cSvg> image;
         Observable<double>::handle_t rotationObserverHandle;
         Observable<std::string>::handle_t sourceObserverHandle;
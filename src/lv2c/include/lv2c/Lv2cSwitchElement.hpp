@@ -50,6 +50,8 @@ namespace lv2c {
         virtual bool WillDraw() const override { return true; }
         virtual bool IsOnOff() const { return false; }
         virtual void OnValueChanged(double value) override;
+        /// @brief The area that changes when the thumb moves between two positions in [0..1].
+        virtual Lv2cRectangle ValueDirtyRect(double oldValue, double newValue) override;
         virtual void OnMount() override;
         virtual void OnUnmount() override;
         virtual void OnDraw(Lv2cDrawingContext &dc) override;
@@ -63,6 +65,9 @@ namespace lv2c {
         BINDING_PROPERTY(Position,double, 0.0);
         BINDING_PROPERTY(Pressed,bool,false);
 
+        void OnPositionChanged(double value);
+        double displayedPosition = 0;
+
         double secondsPerTick;
 
         double trackWidth = -1;
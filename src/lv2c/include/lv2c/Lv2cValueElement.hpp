@@ -48,6 +48,16 @@ namespace lv2c {
 
     protected:
         virtual void OnValueChanged(double value);
+
+        /// @brief The client-area rectangle that changes when the displayed value moves from oldValue to newValue.
+        ///
+        /// Controls whose value is shown by a small moving indicator return the union
+        /// of the indicator's old and new bounds. The default implementation returns
+        /// the entire client area.
+        virtual Lv2cRectangle ValueDirtyRect(double oldValue, double newValue);
+
+        /// @brief Invalidate ValueDirtyRect(oldValue,newValue).
+        void InvalidateValueChange(double oldValue, double newValue);
     };
 
     /// @brief A base class for elements that have mono or stereo values.
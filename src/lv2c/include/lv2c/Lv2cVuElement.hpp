@@ -40,17 +40,33 @@ namespace lv2c
         BINDING_PROPERTY(MinValue, double, 1.0)
     protected:
         virtual void OnValueChanged(double value) override;
+        virtual Lv2cRectangle ValueDirtyRect(double oldValue, double newValue) override;
         virtual void UpdateStyle();
         virtual const Lv2cVuSettings &Settings() const;
         virtual void OnMount() override;
         bool WillDraw() const override { return true; }
         virtual void OnDraw(Lv2cDrawingContext &dc) override;
     private:
+        double displayedValue = 0;
+
         friend class Lv2cStereoVuElement;
         friend class Lv2cDbVuElement;
         friend class Lv2cStereoDbVuElement;
         
         static double ValueToClient(double value, double minValue, double maxValue,const Lv2cRectangle &vuRectangle);
+
+        /// @brief The area occupied by the VU bar(s), excluding ticks.
+        static Lv2cRectangle VuRectangle(const Lv2cRectangle &clientRectangle, const Lv2cVuSettings &settings);
+        /// @brief Split a stereo VU area into left and right bars.
+        static void SplitStereoVuRectangle(const Lv2cRectangle &vuRectangle, const Lv2cVuSettings &settings, Lv2cRectangle *left, Lv2cRectangle *right);
+
+        /// @brief The strip of a VU bar that changes when its level moves from value0 to value1.
+        static Lv2cRectangle LevelChangeRect(
+            const Lv2cRectangle &vuRectangle,
+            double minValue,
+            double maxValue,
+            double value0,
+            double value1);
         static void DrawVu(
             Lv2cDrawingContext &dc, 
             double value,
@@ -88,11 +104,19 @@ namespace lv2c
     protected:
         virtual void OnValueChanged(double value) override;
         virtual void OnRightValueChanged(double value) override;
+        virtual Lv2cRectangle ValueDirtyRect(double oldValue, double newValue) override;
+        Lv2cRectangle RightValueDirtyRect(double oldValue, double newValue);
         virtual void UpdateStyle();
         virtual const Lv2cVuSettings &Settings() const;
         virtual void OnMount() override;
         bool WillDraw() const override { return true; }
         virtual void OnDraw(Lv2cDrawingContext &dc) override;
+    private:
+        void VuBarRectangles(Lv2cRectangle *left, Lv2cRectangle *right);
+
+        double displayedValue = 0;
+        double displayedRightValue = 0;
+        friend class Lv2cStereoDbVuElement;
     };
 
 }
\ No newline at end of file
@@ -28,6 +28,7 @@
 #include "JsonVariant.hpp"
 
 #include "Lv2cDamageList.hpp"
+#include "Lv2cInstrumentation.hpp"
 // #include "Lv2cSvg.hpp"
 
 #include <functional>
@@ -43,8 +44,12 @@ typedef struct _PangoContext PangoContext;
 namespace lv2c
 {
     class Lv2cX11Window;
+    class Lv2cHeadlessWindow;
     class Lv2cTheme;
     class Lv2cSvg;
+    class Lv2cSurfacePool;
+    class Lv2cMeterBallistics;
+    class Lv2cFrameStatisticsHud;
     class FocusNavigationSelector;
 
 
@@ -88,6 +93,7 @@ namespace lv2c
         SouthWest,
         SouthEast
     };
+
     /// @brief Specifies parameters used to create windows.
     struct Lv2cCreateWindowParameters
     {
@@ -224,6 +230,17 @@ namespace lv2c
         /// @param parameters Parameters that control how a window is created.
         void CreateWindow(const Lv2cCreateWindowParameters &parameters);
 
+        /// @brief Create a headless window.
+        /// @param parameters Parameters that control how the window is created. parameters.size must be set.
+        /// @returns The headless backend, which renders frames, advances time and injects input.
+        /// The window renders into an offscreen image surface, and does not require a display connection.
+        /// See Lv2cHeadlessWindow.
+        Lv2cHeadlessWindow &CreateHeadlessWindow(const Lv2cCreateWindowParameters &parameters);
+
+        /// @brief The headless backend of the window.
+        /// @returns nullptr if the window was not created with CreateHeadlessWindow().
+        Lv2cHeadlessWindow *HeadlessWindow() { return headlessWindow.get(); }
+
         /// @brief Create a child of a Lv2cWindow.
         /// @param parent The parent window.
         /// @param parameters
@@ -281,6 +298,33 @@ namespace lv2c
 
         PangoContext *GetPangoContext();
 
+        /// @brief Timings for the most recent frame.
+        /// Reset when animation callbacks for the next frame are run.
+        const Lv2cFrameTimings &FrameTimings() const { return frameTimings; }
+        /// @brief Work counts for the most recently completed frame.
+        const Lv2cFrameCounts &FrameCounts() const { return frameCounts; }
+
+        /// @brief Start recording frames for WriteFrameTrace().
+        /// @param maxFrames The number of most recent frames to retain.
+        /// Discards any previously recorded frames.
+        void StartFrameTrace(size_t maxFrames = 3600);
+        /// @brief Stop recording frames. Recorded frames are retained until the next call to StartFrameTrace().
+        void StopFrameTrace();
+        bool FrameTraceActive() const { return frameTraceActive; }
+        /// @brief Write recorded frames in Chrome trace-event JSON format.
+        void WriteFrameTrace(std::ostream &s) const;
+        void WriteFrameTrace(const std::filesystem::path &path) const;
+
+        /// @brief Show an overlay with frame timings and work counts.
+        /// Can also be toggled with Ctrl+Shift+F12. Drawing the overlay damages the window on every
+        /// frame, so counts include the overlay's own damage rectangle while it is visible.
+        bool ShowFrameStatistics() const { return frameStatisticsHud != nullptr; }
+        Lv2cWindow &ShowFrameStatistics(bool show);
+
+        /// @brief The current time for animation purposes.
+        /// The steady clock for native windows. Headless windows return the time of their synthetic clock.
+        animation_clock_time_point_t Now() const;
+
         AnimationHandle RequestAnimationCallback(const AnimationCallback &callback);
         AnimationHandle RequestAnimationCallback(AnimationCallback &&callback);
         bool CancelAnimationCallback(AnimationHandle handle);
@@ -294,6 +338,14 @@ namespace lv2c
 
         std::shared_ptr<Lv2cSvg> GetSvgImage(const std::string &filename);
         Lv2cSurface GetPngImage(const std::string &filename);
+
+        /// @brief Scratch surfaces for offscreen compositing.
+        /// Used by elements that render through an intermediate buffer, so that buffers
+        /// are recycled between frames instead of being allocated on every paint.
+        Lv2cSurfacePool &SurfacePool();
+
+        /// @brief Shared peak-hold ballistics for the VU meters in this window.
+        Lv2cMeterBallistics &MeterBallistics();
         static void SetResourceDirectories(const std::vector<std::filesystem::path> &paths);
         static std::filesystem::path findResourceFile(const std::filesystem::path &path);
 
@@ -305,6 +357,16 @@ namespace lv2c
 
         bool ModalDisable() const;
 
+        /// @brief Coalesce queued mouse motion events, delivering only the latest position.
+        /// True by default. Set to false to deliver every motion event to every element in the window.
+        /// See also Lv2cElement::WantsAllMouseMotion().
+        bool CoalesceMouseMotion() const { return coalesceMouseMotion; }
+        Lv2cWindow &CoalesceMouseMotion(bool value)
+        {
+            coalesceMouseMotion = value;
+            return *this;
+        }
+
 
         Lv2cCreateWindowParameters& WindowParameters() { return windowParameters; }
 
@@ -349,7 +411,9 @@ namespace lv2c
 
     private:
         Lv2cDrawingContext CreateDrawingContext();
+        cairo_surface_t *NativeSurface();
         void Idle();
+        void EndFrame();
         void Size(const Lv2cSize &size);
 
         // Native Window callback.
@@ -378,6 +442,8 @@ namespace lv2c
 
         void NavigateFocus(FocusNavigationSelector &selector);
 
+        bool WantsAllMouseMotion() const;
+
     private:
         double windowScale = 1.0;
         Lv2cRectangle lastFocusRectangle;
@@ -396,9 +462,17 @@ namespace lv2c
         Lv2cRectangle bounds;
 
         Lv2cDamageList damageList;
+        Lv2cFrameTimings frameTimings;
+        Lv2cFrameCounts frameCounts;
+        Lv2cFrameRecord currentFrame;
+        Lv2cWorkCounters frameStartCounters;
+        std::unique_ptr<Lv2cFrameTrace> frameTrace;
+        bool frameTraceActive = false;
+        std::unique_ptr<Lv2cFrameStatisticsHud> frameStatisticsHud;
 
         bool valid = false;
         bool layoutValid = false;
+        bool coalesceMouseMotion = true;
 
         std::shared_ptr<Lv2cRootElement> rootElement;
 
@@ -420,9 +494,17 @@ namespace lv2c
         std::map<std::string, std::shared_ptr<Lv2cSvg>> svgCache;
         std::map<std::string, Lv2cSurface> pngCache;
 
+        std::shared_ptr<Lv2cSurfacePool> surfacePool;
+
+        std::unique_ptr<Lv2cHeadlessWindow> headlessWindow;
+
+        // Declared last so that it is destroyed while animationCallbacks is still valid.
+        std::unique_ptr<Lv2cMeterBallistics> meterBallistics;
+
 
     private:
         friend class Lv2cX11Window;
+        friend class Lv2cHeadlessWindow;
         friend class Lv2cDialog;
         friend class Lv2cElement;
     };
@@ -431,14 +431,14 @@ public:
                     }
                     catch (const std::exception &e)
                     {
-                        LogDebug(SS("Search: " << e.what() << "(" << entry.path() << ")"));
+                        LV2C_LOG_DEBUG(SS("Search: " << e.what() << "(" << entry.path() << ")"));
                     }
                 }
             }
         }
         catch (const std::exception &e)
         {
-            LogDebug(SS("Search: " << e.what() << "(" << path << ")"));
+            LV2C_LOG_DEBUG(SS("Search: " << e.what() << "(" << path << ")"));
         }
         return true;
     }
@@ -22,6 +22,11 @@
 #include "lv2c/Lv2cDrawingContext.hpp"
 #include <lv2/atom/atom.h>
 #include <cmath>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 using namespace lv2c::ui;
 using namespace lv2c;
@@ -29,11 +34,78 @@ using namespace lv2c;
 static constexpr float MIN_DB = -200;
 static constexpr float MIN_DB_AMPLITUDE = 1e-10f;
 
-static inline float Af2Db(float value)
+// log2(1+t), t in [0,1). Max error 5e-5 (0.0003dB).
+static constexpr float LOG2_C1 = 1.44260389f;
+static constexpr float LOG2_C2 = -0.716714663f;
+static constexpr float LOG2_C3 = 0.440599033f;
+static constexpr float LOG2_C4 = -0.225103025f;
+static constexpr float LOG2_C5 = 0.0586649397f;
+static constexpr float DB_PER_OCTAVE = 6.02059991f; // 20*log10(2)
+
+/// @brief Convert amplitudes to decibels.
+///
+/// log2 is evaluated from the float exponent, and a polynomial over the mantissa,
+/// four values at a time.
+static void Af2Db(const float *input, float *output, size_t count)
 {
-    if (value < MIN_DB_AMPLITUDE)
-        return MIN_DB;
-    return 20.0f * std::log10(value);
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128 minAmplitude = _mm_set1_ps(MIN_DB_AMPLITUDE);
+    const __m128 minDb = _mm_set1_ps(MIN_DB);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128i mantissaMask = _mm_set1_epi32(0x007FFFFF);
+    const __m128i exponentOne = _mm_set1_epi32(0x3F800000);
+    const __m128i exponentBias = _mm_set1_epi32(127);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 x = _mm_loadu_ps(input + i);
+        __m128 underflow = _mm_cmplt_ps(x, minAmplitude);
+        __m128i bits = _mm_castps_si128(x);
+        __m128 exponent = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), exponentBias));
+        __m128 t = _mm_sub_ps(_mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, mantissaMask), exponentOne)), one);
+
+        __m128 p = _mm_set1_ps(LOG2_C5);
+        p = _mm_add_ps(_mm_mul_ps(p, t), _mm_set1_ps(LOG2_C4));
+        p = _mm_add_ps(_mm_mul_ps(p, t), _mm_set1_ps(LOG2_C3));
+        p = _mm_add_ps(_mm_mul_ps(p, t), _mm_set1_ps(LOG2_C2));
+        p = _mm_add_ps(_mm_mul_ps(p, t), _mm_set1_ps(LOG2_C1));
+        p = _mm_mul_ps(p, t);
+
+        __m128 db = _mm_mul_ps(_mm_add_ps(exponent, p), _mm_set1_ps(DB_PER_OCTAVE));
+        db = _mm_or_ps(_mm_and_ps(underflow, minDb), _mm_andnot_ps(underflow, db));
+        _mm_storeu_ps(output + i, db);
+    }
+#elif defined(__ARM_NEON)
+    const float32x4_t minAmplitude = vdupq_n_f32(MIN_DB_AMPLITUDE);
+    const float32x4_t minDb = vdupq_n_f32(MIN_DB);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const uint32x4_t mantissaMask = vdupq_n_u32(0x007FFFFF);
+    const uint32x4_t exponentOne = vdupq_n_u32(0x3F800000);
+    const int32x4_t exponentBias = vdupq_n_s32(127);
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4_t x = vld1q_f32(input + i);
+        uint32x4_t underflow = vcltq_f32(x, minAmplitude);
+        uint32x4_t bits = vreinterpretq_u32_f32(x);
+        float32x4_t exponent = vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(bits, 23)), exponentBias));
+        float32x4_t t = vsubq_f32(vreinterpretq_f32_u32(vorrq_u32(vandq_u32(bits, mantissaMask), exponentOne)), one);
+
+        float32x4_t p = vdupq_n_f32(LOG2_C5);
+        p = vmlaq_f32(vdupq_n_f32(LOG2_C4), p, t);
+        p = vmlaq_f32(vdupq_n_f32(LOG2_C3), p, t);
+        p = vmlaq_f32(vdupq_n_f32(LOG2_C2), p, t);
+        p = vmlaq_f32(vdupq_n_f32(LOG2_C1), p, t);
+        p = vmulq_f32(p, t);
+
+        float32x4_t db = vmulq_n_f32(vaddq_f32(exponent, p), DB_PER_OCTAVE);
+        vst1q_f32(output + i, vbslq_f32(underflow, minDb, db));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        float value = input[i];
+        output[i] = value < MIN_DB_AMPLITUDE ? MIN_DB : 20.0f * std::log10(value);
+    }
 }
 
 // static float DB2A_FACTOR = std::log(10.0f) * 0.05f;
@@ -88,8 +160,6 @@ void Lv2FrequencyPlotElement::PreComputeGridXs()
 void Lv2FrequencyPlotElement::InitUrids()
 {
     urids.propertyUrid = lv2UI->GetUrid(this->frequencyPlot.patchProperty().c_str());
-    urids.atom__Float = lv2UI->GetUrid(LV2_ATOM__Float);
-    urids.atom__Vector = lv2UI->GetUrid(LV2_ATOM__Vector);
 }
 bool Lv2FrequencyPlotElement::WillDraw() const
 {
@@ -105,68 +175,76 @@ void Lv2FrequencyPlotElement::OnMount()
         .Width(frequencyPlot.width());
 
     lv2UI->RequestPatchProperty(this->urids.propertyUrid);
-    propertyEventHandle = lv2UI->OnPatchProperty.AddListener([this](const Lv2UI::PatchPropertyEventArgs &e)
-                                                             {
-        if (e.property == this->urids.propertyUrid)
+    propertyEventHandle = lv2UI->AddFloatVectorPropertyListener(
+        this->urids.propertyUrid,
+        [this](std::span<const float> values)
         {
-            OnValuesChanged(e.value);
-        }
-        return false; });
+            OnValuesChanged(values);
+        });
 }
 void Lv2FrequencyPlotElement::OnUnmount()
 {
-    lv2UI->OnPatchProperty.RemoveListener(propertyEventHandle);
+    lv2UI->RemovePatchPropertyListener(propertyEventHandle);
+    gridLayer.release();
+    curvePath.release();
     super::OnUnmount();
 }
 
-void Lv2FrequencyPlotElement::OnValuesChanged(const void *data)
+void Lv2FrequencyPlotElement::OnValuesChanged(std::span<const float> newValues)
 {
-    const LV2_Atom_Vector *atomVector = (const LV2_Atom_Vector *)data;
-    if (atomVector->atom.type == urids.atom__Vector && atomVector->body.child_type == urids.atom__Float)
+    // xLeft, xRight, yTop, yBottom, followed by the curve values.
+    if (newValues.size() < 4)
+    {
+        return;
+    }
+    size_t count = newValues.size();
+
+    bool axesChanged = true;
+    if (count == this->values.size() + 4)
     {
-        size_t count = (atomVector->atom.size - sizeof(LV2_Atom_Vector_Body)) / atomVector->body.child_size;
-        const float *newValues = (const float *)((const uint8_t *)data + sizeof(LV2_Atom_Vector));
+        bool changed = false;
+        axesChanged = false;
+        axesChanged 
+            = frequencyPlot.xLeft() != newValues[0]
+            || frequencyPlot.xRight() != newValues[1]
+            || frequencyPlot.yTop() != newValues[2]
+            || frequencyPlot.yBottom() != newValues[3];
 
-        bool axesChanged = true;
-        if (count == this->values.size() + 4)
+        for (size_t i = 0; i < values.size(); ++i)
         {
-            bool changed = false;
-            axesChanged = false;
-            axesChanged 
-                = frequencyPlot.xLeft() != newValues[0]
-                || frequencyPlot.xRight() != newValues[1]
-                || frequencyPlot.yTop() != newValues[2]
-                || frequencyPlot.yBottom() != newValues[3];
-
-            for (size_t i = 0; i < values.size(); ++i)
+            if (this->values[i] != newValues[i+4])
             {
-                if (this->values[i] != newValues[i+4])
-                {
-                    changed = true;
-                    break;
-                }
-            }
-            if (!changed && !axesChanged)
-            {
-                return;
+                changed = true;
+                break;
             }
         }
-
-        if (axesChanged)
+        if (!changed && !axesChanged)
         {
-            frequencyPlot.xLeft(newValues[0]);
-            frequencyPlot.xRight(newValues[1]);
-            frequencyPlot.yTop(newValues[2]);
-            frequencyPlot.yBottom(newValues[3]);
-            PreComputeGridXs();
-        } 
-        this->values.resize(count-4);
-        for (size_t i = 0; i < this->values.size(); ++i)
-        {
-            this->values[i] = newValues[i+4];
+            return;
         }
-        Invalidate();
     }
+
+    if (axesChanged)
+    {
+        frequencyPlot.xLeft(newValues[0]);
+        frequencyPlot.xRight(newValues[1]);
+        frequencyPlot.yTop(newValues[2]);
+        frequencyPlot.yBottom(newValues[3]);
+        PreComputeGridXs();
+    } 
+    if (axesChanged)
+    {
+        gridLayer.release();
+    }
+    this->values.resize(count-4);
+    for (size_t i = 0; i < this->values.size(); ++i)
+    {
+        this->values[i] = newValues[i+4];
+    }
+    this->dbValues.resize(this->values.size());
+    Af2Db(this->values.data(), this->dbValues.data(), this->values.size());
+    curvePath.release();
+    Invalidate();
 }
 
 void Lv2FrequencyPlotElement::DrawTicks(Lv2cDrawingContext &dc)
@@ -174,50 +252,137 @@ void Lv2FrequencyPlotElement::DrawTicks(Lv2cDrawingContext &dc)
     Lv2cSize clientSize = this->ClientSize();
     constexpr double minorTickWidth = 0.20;
     constexpr double majorTickWidth = 0.35;
+
+    // Lines of the same width are collected into a single path, and stroked once.
+    double gxScale = clientSize.Width()/this->frequencyPlot.width();
+
+    // solve for m, c:
+    // f(x) = m*x+c;
+    // f(yBottom) = height()
+    // f(yTop) = 0
+    //  m*yTop + c =0
+    //  m*yBottom+c = height()
+    // m*(yBottom-yTop) = height()
+    double m = clientSize.Height() / (frequencyPlot.yBottom() - frequencyPlot.yTop());
+    double c = -m * frequencyPlot.yTop();
+    double dbStart = std::floor(frequencyPlot.yBottom() / 10) * 10 + 10;
+
     dc.set_source(Theme().plotTickColor);
-    dc.set_line_width(minorTickWidth);
     dc.set_line_cap(cairo_line_cap_t::CAIRO_LINE_CAP_BUTT);
-    for (double x : minorGridXs)
+
+    dc.new_path();
+    for (double gx : minorGridXs)
     {
+        double x = gx*gxScale;
         dc.move_to(x, 0);
         dc.line_to(x, clientSize.Height());
-        dc.stroke();
     }
-    dc.set_line_width(majorTickWidth);
-    double gxScale = clientSize.Width()/this->frequencyPlot.width();
+    for (double db = dbStart; db < frequencyPlot.yTop(); db += 10)
+    {
+        if (db != 0)
+        {
+            double y = m * db + c;
+            dc.move_to(0, y);
+            dc.line_to(clientSize.Width(), y);
+        }
+    }
+    dc.set_line_width(minorTickWidth);
+    dc.stroke();
+
+    dc.new_path();
     for (double gx : majorGridXs)
     {
         double x = gx*gxScale;
         dc.move_to(x, 0);
         dc.line_to(x, clientSize.Height());
-        dc.stroke();
+    }
+    if (frequencyPlot.yBottom() < 0 && frequencyPlot.yTop() > 0)
+    {
+        double y = c;
+        dc.move_to(0, y);
+        dc.line_to(clientSize.Width(), y);
+    }
+    dc.set_line_width(majorTickWidth);
+    dc.stroke();
+}
+
+void Lv2FrequencyPlotElement::DrawGridLayer(Lv2cDrawingContext &dc)
+{
+    Lv2cRectangle clientRect{ClientSize()};
+
+    // Render at device resolution, aligned to device pixels.
+    Lv2cRectangle deviceRect = dc.user_to_device(clientRect).Ceiling();
+    Lv2cRectangle userRect = dc.device_to_user(deviceRect);
+    Lv2cSize deviceSize{std::round(deviceRect.Width()), std::round(deviceRect.Height())};
+    if (deviceSize.Width() <= 0 || deviceSize.Height() <= 0)
+    {
+        return;
     }
 
+    const Lv2cColor &tickColor = Theme().plotTickColor;
+    if (!gridLayer || !(gridLayerBounds == userRect) || !(gridLayerDeviceSize == deviceSize) || !(gridLayerColor == tickColor))
     {
-        // solve for m, c:
-        // f(x) = m*x+c;
-        // f(yBottom) = height()
-        // f(yTop) = 0
-        //  m*yTop + c =0
-        //  m*yBottom+c = height()
-        // m*(yBottom-yTop) = height()
+        gridLayer = Lv2cImageSurface(
+            cairo_format_t::CAIRO_FORMAT_ARGB32,
+            (int)deviceSize.Width(), (int)deviceSize.Height());
+        gridLayerBounds = userRect;
+        gridLayerDeviceSize = deviceSize;
+        gridLayerColor = tickColor;
+
+        Lv2cDrawingContext layerDc(gridLayer);
+        layerDc.scale(deviceSize.Width() / userRect.Width(), deviceSize.Height() / userRect.Height());
+        layerDc.translate(-userRect.Left(), -userRect.Top());
+        DrawTicks(layerDc);
+    }
 
-        dc.set_line_width(0.35);
+    dc.save();
+    {
+        dc.translate(userRect.Left(), userRect.Top());
+        dc.scale(userRect.Width() / deviceSize.Width(), userRect.Height() / deviceSize.Height());
+        dc.rectangle(Lv2cRectangle(0, 0, deviceSize.Width(), deviceSize.Height()));
+        Lv2cPattern pattern(gridLayer);
+        dc.set_source(pattern);
+        dc.fill();
+    }
+    dc.restore();
+}
 
+void Lv2FrequencyPlotElement::DrawCurve(Lv2cDrawingContext &dc)
+{
+    size_t count = this->dbValues.size();
+    if (count <= 1)
+    {
+        return;
+    }
+    auto clientSize = ClientSize();
+    if (!curvePath || !(curvePathSize == clientSize))
+    {
+        double dx = clientSize.Width() / (count - 1);
+        // y = m*x+c;
+        // f(MAX_Y) = 0;
+        // f(MIN_Y) = frequencyPlot.width()
         double m = clientSize.Height() / (frequencyPlot.yBottom() - frequencyPlot.yTop());
-        double c = -m * frequencyPlot.yTop();
-        for (
-            double db = std::floor(frequencyPlot.yBottom() / 10) * 10 + 10;
-            db < frequencyPlot.yTop();
-            db += 10)
+        double c = -frequencyPlot.yTop() * m;
+
+        dc.new_path();
+        dc.move_to(-1, m * dbValues[0] + c);
+        for (size_t i = 0; i < count; ++i)
         {
-            double y = m * db + c;
-            dc.set_line_width(db == 0 ? majorTickWidth : minorTickWidth);
-            dc.move_to(0, y);
-            dc.line_to(frequencyPlot.width(), y);
-            dc.stroke();
+            dc.line_to(dx * i, m * dbValues[i] + c);
         }
+        curvePath = dc.copy_path();
+        curvePathSize = clientSize;
+    }
+    else
+    {
+        dc.new_path();
+        dc.append_path(curvePath);
     }
+    dc.set_line_cap(cairo_line_cap_t::CAIRO_LINE_CAP_ROUND);
+    dc.set_line_width(3);
+
+    dc.set_source(Theme().plotColor);
+    dc.stroke();
 }
 
 void Lv2FrequencyPlotElement::OnDraw(Lv2cDrawingContext &dc)
@@ -232,37 +397,8 @@ void Lv2FrequencyPlotElement::OnDraw(Lv2cDrawingContext &dc)
         dc.round_corner_rectangle(clientRect, corners);
         dc.clip();
 
-        DrawTicks(dc);
-        size_t count = this->values.size();
-        auto clientSize = ClientSize();
-        if (count > 1)
-        {
-            double dx = clientSize.Width() / (count - 1);
-            // y = m*x+c;
-            // f(MAX_Y) = 0;
-            // f(MIN_Y) = frequencyPlot.width()
-            double m = clientSize.Height() / (frequencyPlot.yBottom() - frequencyPlot.yTop());
-            double c = -frequencyPlot.yTop() * m;
-
-            for (size_t i = 0; i < count; ++i)
-            {
-                double x = dx * i;
-                double y = values[i];
-                y = Af2Db(y);
-                y = m * y + c;
-                if (i == 0)
-                {
-                    dc.move_to(x-1, y);
-                    
-                }
-                dc.line_to(x, y);
-            }
-            dc.set_line_cap(cairo_line_cap_t::CAIRO_LINE_CAP_ROUND);
-            dc.set_line_width(3);
-
-            dc.set_source(Theme().plotColor);
-            dc.stroke();
-        }
+        DrawGridLayer(dc);
+        DrawCurve(dc);
     }
     dc.restore();
-}
\ No newline at end of file
+}
@@ -0,0 +1,119 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "lv2c_ui/Lv2PatchPropertyListeners.hpp"
+#include <algorithm>
+
+using namespace lv2c;
+using namespace lv2c::ui;
+
+EventHandle Lv2PatchPropertyListeners::Add(LV2_URID property, Listener &&listener)
+{
+    EventHandle handle = EventHandle::Next();
+    listeners[property].push_back(Entry{handle.getHandle(), std::move(listener)});
+    listenerProperties[handle.getHandle()] = property;
+    return handle;
+}
+
+bool Lv2PatchPropertyListeners::Remove(EventHandle handle)
+{
+    auto f = listenerProperties.find(handle.getHandle());
+    if (f == listenerProperties.end())
+    {
+        return false;
+    }
+    auto fListeners = listeners.find(f->second);
+    listenerProperties.erase(f);
+    if (fListeners == listeners.end())
+    {
+        return false;
+    }
+    auto &entries = fListeners->second;
+    for (auto i = entries.begin(); i != entries.end(); ++i)
+    {
+        if (i->handle == handle.getHandle())
+        {
+            if (dispatching)
+            {
+                // The listener may be the one that is currently running, so it
+                // can't be destroyed until dispatch completes.
+                i->removed = true;
+                removedDuringDispatch = true;
+            }
+            else
+            {
+                entries.erase(i);
+                if (entries.empty())
+                {
+                    listeners.erase(fListeners);
+                }
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void Lv2PatchPropertyListeners::Dispatch(LV2_URID property, const LV2_Atom *value)
+{
+    auto f = listeners.find(property);
+    if (f == listeners.end())
+    {
+        return;
+    }
+    bool nested = dispatching;
+    dispatching = true;
+    auto &entries = f->second;
+    // listeners added during dispatch are not called until the next message.
+    size_t size = entries.size();
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (!entries[i].removed)
+        {
+            entries[i].listener(value);
+        }
+    }
+    dispatching = nested;
+    if (!nested && removedDuringDispatch)
+    {
+        Compact();
+    }
+}
+
+void Lv2PatchPropertyListeners::Compact()
+{
+    removedDuringDispatch = false;
+    for (auto i = listeners.begin(); i != listeners.end(); /**/)
+    {
+        auto &entries = i->second;
+        entries.erase(
+            std::remove_if(entries.begin(), entries.end(), [](const Entry &entry)
+                           { return entry.removed; }),
+            entries.end());
+        if (entries.empty())
+        {
+            i = listeners.erase(i);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
@@ -0,0 +1,421 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "lv2c_ui/Lv2SpectrumElement.hpp"
+#include "lv2c/Lv2cDrawingContext.hpp"
+#include "lv2c/Lv2cWindow.hpp"
+#include <lv2/atom/atom.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace lv2c::ui;
+using namespace lv2c;
+
+static constexpr float MIN_DB = -200;
+static constexpr float MIN_DB_AMPLITUDE = 1e-10f;
+
+void Lv2SpectrumColumns::SpectrumLayout(size_t columns, size_t binCount, double sampleRate, double minFrequency, double maxFrequency)
+{
+    mode = Lv2SpectrumMode::Spectrum;
+    inputSize = binCount;
+    start.resize(columns);
+    end.resize(columns);
+    fraction.resize(columns);
+    min.resize(columns);
+    max.resize(columns);
+
+    if (binCount < 2 || sampleRate <= 0 || minFrequency <= 0 || maxFrequency <= minFrequency)
+    {
+        for (size_t x = 0; x < columns; ++x)
+        {
+            start[x] = 0;
+            end[x] = (uint32_t)binCount;
+            fraction[x] = 0;
+        }
+        return;
+    }
+    double binsPerHz = (binCount - 1) / (sampleRate / 2);
+    double logRatio = std::log(maxFrequency / minFrequency);
+    double lastBin = (double)(binCount - 1);
+
+    for (size_t x = 0; x < columns; ++x)
+    {
+        double b0 = minFrequency * std::exp(logRatio * x / columns) * binsPerHz;
+        double b1 = minFrequency * std::exp(logRatio * (x + 1) / columns) * binsPerHz;
+        double first = std::min(std::ceil(b0), (double)binCount);
+        double last = std::min(std::ceil(b1), (double)binCount);
+        if (last > first)
+        {
+            start[x] = (uint32_t)first;
+            end[x] = (uint32_t)last;
+            fraction[x] = 0;
+        }
+        else
+        {
+            // The column lies between two bins.
+            double center = std::min((b0 + b1) / 2, lastBin);
+            double bin = std::min(std::floor(center), lastBin - 1);
+            start[x] = end[x] = (uint32_t)bin;
+            fraction[x] = (float)(center - bin);
+        }
+    }
+}
+
+void Lv2SpectrumColumns::WaveformLayout(size_t columns, size_t sampleCount)
+{
+    mode = Lv2SpectrumMode::Waveform;
+    inputSize = sampleCount;
+    start.resize(columns);
+    end.resize(columns);
+    fraction.resize(columns);
+    min.resize(columns);
+    max.resize(columns);
+
+    for (size_t x = 0; x < columns; ++x)
+    {
+        size_t s0 = x * sampleCount / columns;
+        size_t s1 = (x + 1) * sampleCount / columns;
+        if (sampleCount != 0)
+        {
+            s0 = std::min(s0, sampleCount - 1);
+            s1 = std::max(s1, s0 + 1);
+        }
+        start[x] = (uint32_t)s0;
+        end[x] = (uint32_t)s1;
+        fraction[x] = 0;
+    }
+}
+
+void Lv2SpectrumColumns::Reduce(const float *values)
+{
+    size_t columns = max.size();
+    if (inputSize == 0)
+    {
+        std::fill(min.begin(), min.end(), 0.0f);
+        std::fill(max.begin(), max.end(), 0.0f);
+        return;
+    }
+    if (mode == Lv2SpectrumMode::Spectrum)
+    {
+        for (size_t x = 0; x < columns; ++x)
+        {
+            uint32_t i = start[x];
+            float value;
+            if (i == end[x])
+            {
+                value = values[i] + (values[i + 1] - values[i]) * fraction[x];
+            }
+            else
+            {
+                value = values[i];
+                for (++i; i < end[x]; ++i)
+                {
+                    value = std::max(value, values[i]);
+                }
+            }
+            min[x] = max[x] = value;
+        }
+    }
+    else
+    {
+        for (size_t x = 0; x < columns; ++x)
+        {
+            uint32_t i = start[x];
+            float lo = values[i];
+            float hi = values[i];
+            for (++i; i < end[x]; ++i)
+            {
+                lo = std::min(lo, values[i]);
+                hi = std::max(hi, values[i]);
+            }
+            min[x] = lo;
+            max[x] = hi;
+        }
+    }
+}
+
+Lv2SpectrumElement::Lv2SpectrumElement()
+{
+    ModeProperty.SetElement(this, &Lv2SpectrumElement::OnModePropertyChanged);
+    SampleRateProperty.SetElement(this, &Lv2SpectrumElement::OnLayoutPropertyChanged);
+    MinFrequencyProperty.SetElement(this, &Lv2SpectrumElement::OnLayoutPropertyChanged);
+    MaxFrequencyProperty.SetElement(this, &Lv2SpectrumElement::OnLayoutPropertyChanged);
+    MinDbProperty.SetElement(this, Lv2cBindingFlags::InvalidateOnChanged);
+    MaxDbProperty.SetElement(this, Lv2cBindingFlags::InvalidateOnChanged);
+}
+
+Lv2SpectrumElement::Lv2SpectrumElement(Lv2UI *lv2UI, const std::string &patchProperty)
+    : Lv2SpectrumElement()
+{
+    this->lv2UI = lv2UI;
+    propertyUrid = lv2UI->GetUrid(patchProperty.c_str());
+}
+
+bool Lv2SpectrumElement::WillDraw() const
+{
+    return true;
+}
+
+void Lv2SpectrumElement::OnMount()
+{
+    this->ClearClasses();
+    super::OnMount();
+    this->AddClass(Theme().plotStyle);
+
+    if (lv2UI)
+    {
+        lv2UI->RequestPatchProperty(this->propertyUrid);
+        propertyEventHandle = lv2UI->AddFloatVectorPropertyListener(
+            this->propertyUrid,
+            [this](std::span<const float> values)
+            {
+                SetValues(values.data(), values.size());
+            });
+    }
+    if (framePending)
+    {
+        RequestFrame();
+    }
+}
+
+void Lv2SpectrumElement::OnUnmount()
+{
+    if (lv2UI)
+    {
+        lv2UI->RemovePatchPropertyListener(propertyEventHandle);
+    }
+    if (animationHandle)
+    {
+        Window()->CancelAnimationCallback(animationHandle);
+        animationHandle = AnimationHandle::InvalidHandle;
+    }
+    hasLastFrameTime = false;
+    super::OnUnmount();
+}
+
+void Lv2SpectrumElement::OnLayoutPropertyChanged(double value)
+{
+    columnsValid = false;
+}
+
+void Lv2SpectrumElement::OnModePropertyChanged(Lv2SpectrumMode value)
+{
+    columnsValid = false;
+    std::fill(levels.begin(), levels.end(), 0.0f);
+    std::fill(minLevels.begin(), minLevels.end(), 0.0f);
+    peaksActive = false;
+    Invalidate();
+}
+
+void Lv2SpectrumElement::SetValues(const float *values, size_t count)
+{
+    // Frames arriving faster than the display rate overwrite each other. The buffer only
+    // grows if the frame size grows.
+    if (pendingValues.size() < count)
+    {
+        pendingValues.resize(count);
+    }
+    std::copy(values, values + count, pendingValues.begin());
+    pendingCount = count;
+    framePending = true;
+    RequestFrame();
+}
+
+void Lv2SpectrumElement::RequestFrame()
+{
+    if (!animationHandle && Window())
+    {
+        animationHandle = Window()->RequestAnimationCallback(
+            [this](const animation_clock_time_point_t &now)
+            {
+                OnAnimationFrame(now);
+            });
+    }
+}
+
+void Lv2SpectrumElement::UpdateLayout(size_t inputSize)
+{
+    size_t width = (size_t)std::ceil(ClientSize().Width());
+    if (columnsValid && width == columnCount && inputSize == columns.InputSize() && Mode() == columns.Mode())
+    {
+        return;
+    }
+    columnsValid = true;
+    columnCount = width;
+    if (Mode() == Lv2SpectrumMode::Spectrum)
+    {
+        columns.SpectrumLayout(width, inputSize, SampleRate(), MinFrequency(), MaxFrequency());
+    }
+    else
+    {
+        columns.WaveformLayout(width, inputSize);
+    }
+    levels.resize(width);
+    minLevels.resize(width);
+    peaks.resize(width);
+    std::fill(peaks.begin(), peaks.end(), MIN_DB);
+    peaksActive = false;
+}
+
+void Lv2SpectrumElement::UpdateColumns()
+{
+    const std::vector<float> &columnMax = columns.Max();
+    const std::vector<float> &columnMin = columns.Min();
+    size_t n = levels.size();
+    if (Mode() == Lv2SpectrumMode::Waveform)
+    {
+        for (size_t x = 0; x < n; ++x)
+        {
+            levels[x] = columnMax[x];
+            minLevels[x] = columnMin[x];
+        }
+        return;
+    }
+    for (size_t x = 0; x < n; ++x)
+    {
+        float value = columnMax[x];
+        levels[x] = value < MIN_DB_AMPLITUDE ? MIN_DB : 20.0f * std::log10(value);
+    }
+}
+
+void Lv2SpectrumElement::OnAnimationFrame(const animation_clock_time_point_t &now)
+{
+    animationHandle = AnimationHandle::InvalidHandle;
+
+    double seconds = 0;
+    if (hasLastFrameTime)
+    {
+        seconds = std::chrono::duration<double>(now - lastFrameTime).count();
+    }
+    lastFrameTime = now;
+    hasLastFrameTime = true;
+
+    bool changed = false;
+    if (framePending)
+    {
+        framePending = false;
+        UpdateLayout(pendingCount);
+        columns.Reduce(pendingValues.data());
+        UpdateColumns();
+        changed = true;
+    }
+    if (Mode() == Lv2SpectrumMode::Spectrum && (changed || peaksActive))
+    {
+        float decay = (float)(PeakDecay() * seconds);
+        peaksActive = false;
+        for (size_t x = 0; x < peaks.size(); ++x)
+        {
+            float peak = std::max(peaks[x] - decay, levels[x]);
+            peaks[x] = peak;
+            if (peak > levels[x])
+            {
+                peaksActive = true;
+            }
+        }
+        changed = true;
+    }
+    if (changed)
+    {
+        Invalidate();
+    }
+    if (peaksActive || framePending)
+    {
+        RequestFrame();
+    }
+    else
+    {
+        hasLastFrameTime = false;
+    }
+}
+
+void Lv2SpectrumElement::OnDraw(Lv2cDrawingContext &dc)
+{
+    super::OnDraw(dc);
+    size_t n = levels.size();
+    if (n == 0)
+    {
+        return;
+    }
+    Lv2cSize clientSize = ClientSize();
+    Lv2cRectangle clientRect{clientSize};
+    double width = clientSize.Width();
+    double height = clientSize.Height();
+    double dx = width / n;
+
+    dc.save();
+    {
+        Lv2cRoundCorners corners = Style().RoundCorners().PixelValue();
+        dc.round_corner_rectangle(clientRect, corners);
+        dc.clip();
+
+        Lv2cColor color = Theme().plotColor;
+        if (Mode() == Lv2SpectrumMode::Spectrum)
+        {
+            // y = m*db+c; f(MaxDb) = 0; f(MinDb) = height
+            double m = height / (MinDb() - MaxDb());
+            double c = -MaxDb() * m;
+            auto dbToY = [m, c, height](float db)
+            {
+                return std::clamp(m * db + c, -1.0, height + 1);
+            };
+
+            dc.new_path();
+            dc.move_to(0, height + 1);
+            for (size_t x = 0; x < n; ++x)
+            {
+                dc.line_to((x + 0.5) * dx, dbToY(levels[x]));
+            }
+            dc.line_to(width, height + 1);
+            dc.close_path();
+            dc.set_source(Lv2cColor(color, 0.5));
+            dc.fill();
+
+            dc.new_path();
+            dc.move_to(0.5 * dx, dbToY(peaks[0]));
+            for (size_t x = 1; x < n; ++x)
+            {
+                dc.line_to((x + 0.5) * dx, dbToY(peaks[x]));
+            }
+            dc.set_line_width(1);
+            dc.set_source(color);
+            dc.stroke();
+        }
+        else
+        {
+            double c = height / 2;
+            double m = -height / 2;
+
+            dc.new_path();
+            for (size_t x = 0; x < n; ++x)
+            {
+                dc.line_to((x + 0.5) * dx, c + m * levels[x]);
+            }
+            for (size_t x = n; x-- > 0;)
+            {
+                dc.line_to((x + 0.5) * dx, c + m * minLevels[x]);
+            }
+            dc.close_path();
+            dc.set_source(color);
+            dc.set_line_width(1);
+            dc.fill_preserve();
+            dc.stroke();
+        }
+    }
+    dc.restore();
+}
@@ -63,24 +63,38 @@ void Lv2TunerElement::OnMount()
         .FontWeight(Lv2cFontWeight::Normal);
 }
 
-void Lv2TunerElement::DrawDial(Lv2cDrawingContext &dc, double midiNote)
+void Lv2TunerElement::OnUnmount()
 {
-    double cents;
-    if (midiNote < 0)
+    dialLayer.release();
+    dialLayerBackground = Lv2cPattern();
+    dialLayerColor = Lv2cPattern();
+    super::OnUnmount();
+}
+
+double Lv2TunerElement::MidiNote()
+{
+    if (this->ValueIsMidiNote())
     {
-        cents = -0.50;
+        return Value();
     }
-    else
+    double frequency = Value();
+    if (frequency <= 0)
     {
-        int iNote = (int)std::round(midiNote);
-        cents = midiNote - iNote;
+        return -1;
     }
+    return std::log2(frequency / ReferenceFrequency()) * 12 + 69;
+}
 
+void Lv2TunerElement::DrawDialScale(Lv2cDrawingContext &dc)
+{
     Lv2cRectangle clientSize = this->ClientSize();
     double radius = clientSize.Width()*1;
     double maxAngle = std::tan((clientSize.Width()*0.45)/radius);
     double dialScale = maxAngle/0.30;
 
+    dc.set_source(Style().Background());
+    dc.round_corner_rectangle(clientSize,Style().RoundCorners().PixelValue());
+    dc.fill();
 
     dc.save();
     {
@@ -103,129 +117,186 @@ void Lv2TunerElement::DrawDial(Lv2cDrawingContext &dc, double midiNote)
                 dc.line_to(1,innerRadius);
                 dc.line_to(-1,innerRadius);
                 dc.close_path();
-                dc.fill();
             }
             dc.restore();
         }
-
-        dc.save();
-        {
-            if (cents < -0.30) cents = -0.30;
-            if (cents > 0.30) cents = 0.30;
-            double needleAngle = cents*dialScale;
-            dc.rotate(needleAngle);
-            dc.move_to(-3,0);
-            dc.line_to(-1,-radius);
-            dc.line_to(1,-radius);
-            dc.line_to(3,0);
-            dc.close_path();
-            dc.set_source(Lv2cColor("#800000"));
-            dc.fill();
-        }
-        dc.restore();
+        dc.fill();
     }
     dc.restore();
+}
 
+void Lv2TunerElement::DrawDialLayer(Lv2cDrawingContext &dc)
+{
+    Lv2cRectangle clientRect{ClientSize()};
 
+    // Render at device resolution, aligned to device pixels.
+    Lv2cRectangle deviceRect = dc.user_to_device(clientRect).Ceiling();
+    Lv2cRectangle userRect = dc.device_to_user(deviceRect);
+    Lv2cSize deviceSize{std::round(deviceRect.Width()), std::round(deviceRect.Height())};
+    if (deviceSize.Width() <= 0 || deviceSize.Height() <= 0)
+    {
+        return;
+    }
 
+    // Style setters install new pattern objects, so comparing pattern identity detects style changes.
+    const Lv2cPattern &background = Style().Background();
+    const Lv2cPattern &color = Style().Color();
+    if (!dialLayer || !(dialLayerBounds == userRect) || !(dialLayerDeviceSize == deviceSize) ||
+        background.get() != dialLayerBackground.get() || color.get() != dialLayerColor.get())
+    {
+        dialLayer = Lv2cImageSurface(
+            cairo_format_t::CAIRO_FORMAT_ARGB32,
+            (int)deviceSize.Width(), (int)deviceSize.Height());
+        dialLayerBounds = userRect;
+        dialLayerDeviceSize = deviceSize;
+        dialLayerBackground = background;
+        dialLayerColor = color;
+
+        Lv2cDrawingContext layerDc(dialLayer);
+        layerDc.scale(deviceSize.Width() / userRect.Width(), deviceSize.Height() / userRect.Height());
+        layerDc.translate(-userRect.Left(), -userRect.Top());
+        DrawDialScale(layerDc);
+    }
+
+    dc.save();
+    {
+        dc.translate(userRect.Left(), userRect.Top());
+        dc.scale(userRect.Width() / deviceSize.Width(), userRect.Height() / deviceSize.Height());
+        dc.rectangle(Lv2cRectangle(0, 0, deviceSize.Width(), deviceSize.Height()));
+        Lv2cPattern pattern(dialLayer);
+        dc.set_source(pattern);
+        dc.fill();
+    }
+    dc.restore();
 }
 
-void Lv2TunerElement::DrawText(Lv2cDrawingContext &dc, double midiNote)
+void Lv2TunerElement::DrawNeedle(Lv2cDrawingContext &dc, double midiNote)
 {
-
-    std::string noteName;
-    std::string centsText;
+    double cents;
     if (midiNote < 0)
     {
-        noteName = "−−";
-        centsText = "−−";
+        cents = -0.50;
     }
     else
     {
         int iNote = (int)std::round(midiNote);
-        double cents = midiNote-iNote;
-        int octave = iNote / 12;
-        int pitch = iNote - octave * 12;
-
-        std::stringstream s;
-        static const char *PITCH_NAMES[] = {
-            "C", "C♯", "D", "E♭", "E", "F", "F♯", "G", "A♭", "A", "B♭", "B"};
-        s << PITCH_NAMES[pitch] << (octave-1);
-        noteName = s.str();
-
-        std::stringstream sc;
-        int iCents = (int)std::round(cents * 100);
-        if (iCents < 0)
+        cents = midiNote - iNote;
+    }
+
+    Lv2cRectangle clientSize = this->ClientSize();
+    double radius = clientSize.Width()*1;
+    double maxAngle = std::tan((clientSize.Width()*0.45)/radius);
+    double dialScale = maxAngle/0.30;
+
+    dc.save();
+    {
+        dc.translate(clientSize.Width()/2,radius+8);
+
+        if (cents < -0.30) cents = -0.30;
+        if (cents > 0.30) cents = 0.30;
+        double needleAngle = cents*dialScale;
+        dc.rotate(needleAngle);
+        dc.move_to(-3,0);
+        dc.line_to(-1,-radius);
+        dc.line_to(1,-radius);
+        dc.line_to(3,0);
+        dc.close_path();
+        dc.set_source(Lv2cColor("#800000"));
+        dc.fill();
+    }
+    dc.restore();
+}
+
+static Lv2cSize GetLayoutSize(PangoLayout *layout)
+{
+    PangoRectangle inkRect, logicalRect;
+    pango_layout_get_extents(layout, &inkRect, &logicalRect);
+    return Lv2cSize(std::ceil(logicalRect.width / PANGO_SCALE), std::ceil(logicalRect.height / PANGO_SCALE));
+}
+
+void Lv2TunerElement::UpdateText(double midiNote)
+{
+    int iNote = NO_VALUE;
+    int iCents = NO_VALUE;
+    if (midiNote >= 0)
+    {
+        iNote = (int)std::round(midiNote);
+        iCents = (int)std::round((midiNote - iNote) * 100);
+    }
+
+    if (iNote != displayedNote)
+    {
+        displayedNote = iNote;
+        std::string noteName;
+        if (iNote == NO_VALUE)
         {
-            sc << "−.";
-            iCents = -iCents;
+            noteName = "−−";
         }
         else
         {
-            sc << "+.";
+            int octave = iNote / 12;
+            int pitch = iNote - octave * 12;
+
+            static const char *PITCH_NAMES[] = {
+                "C", "C♯", "D", "E♭", "E", "F", "F♯", "G", "A♭", "A", "B♭", "B"};
+            noteName = PITCH_NAMES[pitch] + std::to_string(octave - 1);
         }
-        sc << (char)('0' + (iCents / 10 % 10));
-        sc << (char)('0' + (iCents % 10));
-        centsText = sc.str();
+        pango_layout_set_text(noteLayout, noteName.c_str(), (int)(noteName.length()));
+        noteTextSize = GetLayoutSize(noteLayout);
     }
+
+    if (iCents != displayedCents)
+    {
+        displayedCents = iCents;
+        std::string centsText;
+        if (iCents == NO_VALUE)
+        {
+            centsText = "−−";
+        }
+        else
+        {
+            int absCents = std::abs(iCents);
+            centsText = iCents < 0 ? "−." : "+.";
+            centsText += (char)('0' + (absCents / 10 % 10));
+            centsText += (char)('0' + (absCents % 10));
+        }
+        pango_layout_set_text(centsLayout, centsText.c_str(), (int)(centsText.length()));
+        centsTextSize = GetLayoutSize(centsLayout);
+    }
+}
+
+void Lv2TunerElement::DrawText(Lv2cDrawingContext &dc, double midiNote)
+{
+    UpdateText(midiNote);
+
     dc.set_source(Style().Color());
-    pango_layout_set_text(pangoLayout, noteName.c_str(), (int)(noteName.length()));
-    PangoRectangle inkRect, logicalRect;
-    pango_layout_get_extents(pangoLayout, &inkRect, &logicalRect);
-    Lv2cSize pangoSize = Lv2cSize(std::ceil(logicalRect.width / PANGO_SCALE), std::ceil(logicalRect.height / PANGO_SCALE));
 
     double center = std::floor(clientSize.Width() / 2);
     constexpr double TEXT_SPACE = 16;
     Lv2cPoint ptText = dc.round_to_device(
         Lv2cPoint(
             32,
-            clientSize.Height() - pangoSize.Height()));
+            clientSize.Height() - noteTextSize.Height()));
 
     dc.move_to(ptText.x, ptText.y);
-    pango_cairo_show_layout(dc.get(), pangoLayout);
+    pango_cairo_show_layout(dc.get(), noteLayout);
 
-    pango_layout_set_text(pangoLayout, centsText.c_str(), (int)(centsText.length()));
-    pango_layout_get_extents(pangoLayout, &inkRect, &logicalRect);
-    pangoSize = Lv2cSize(std::ceil(logicalRect.width / PANGO_SCALE), std::ceil(logicalRect.height / PANGO_SCALE));
     ptText = dc.round_to_device(Lv2cPoint(
         center + TEXT_SPACE,
-        clientSize.Height() - pangoSize.Height()));
+        clientSize.Height() - centsTextSize.Height()));
 
     dc.move_to(ptText.x, ptText.y);
-    pango_cairo_show_layout(dc.get(), pangoLayout);
+    pango_cairo_show_layout(dc.get(), centsLayout);
 }
 void Lv2TunerElement::OnDraw(Lv2cDrawingContext &dc)
 {
     PreparePangoContext();
-    Lv2cRectangle rcClient{ClientSize()};
-
-    auto roundCorners = Style().RoundCorners().PixelValue();
-    {
-
-
-        dc.set_source(Style().Background());
-        dc.round_corner_rectangle(rcClient,roundCorners);
-        dc.fill();
-
 
-        double midiNote;
-        if (this->ValueIsMidiNote())
-        {
-            midiNote = Value();
-        } else {
-
-            double frequency = Value();
-            if (frequency <= 0)
-            {
-                midiNote = -1;
-            } {
-                midiNote = std::log2(frequency/ReferenceFrequency())*12 + 69;
-            }
-        }
+    double midiNote = MidiNote();
 
-        DrawText(dc,midiNote);
-        DrawDial(dc,midiNote);
-    }
+    DrawDialLayer(dc);
+    DrawText(dc,midiNote);
+    DrawNeedle(dc,midiNote);
 }
 
 Lv2TunerElement::~Lv2TunerElement()
@@ -234,23 +305,30 @@ Lv2TunerElement::~Lv2TunerElement()
 }
 void Lv2TunerElement::PreparePangoContext()
 {
-    if (pangoLayout == nullptr)
+    if (noteLayout == nullptr)
     {
-
-        // pangoLayout = pango_cairo_create_layout(context.get());
-
-        pangoLayout = pango_layout_new(GetPangoContext());
         auto fontDescriptor = gPangoContext.GetFontDescription(this->Style());
-        pango_layout_set_font_description(pangoLayout, fontDescriptor);
+        noteLayout = pango_layout_new(GetPangoContext());
+        pango_layout_set_font_description(noteLayout, fontDescriptor);
+        centsLayout = pango_layout_new(GetPangoContext());
+        pango_layout_set_font_description(centsLayout, fontDescriptor);
         pango_font_description_free(fontDescriptor);
+
+        displayedNote = INVALID_TEXT;
+        displayedCents = INVALID_TEXT;
     }
 }
 
 void Lv2TunerElement::FreePangoContext()
 {
-    if (pangoLayout)
+    if (noteLayout)
+    {
+        g_object_unref(noteLayout);
+        noteLayout = nullptr;
+    }
+    if (centsLayout)
     {
-        g_object_unref(pangoLayout);
-        pangoLayout = nullptr;
+        g_object_unref(centsLayout);
+        centsLayout = nullptr;
     }
 }
@@ -50,6 +50,7 @@
 
 #include <vector>
 #include <string.h>
+#include <algorithm>
 
 #include "lv2c/Lv2cGroupElement.hpp"
 
@@ -60,6 +61,43 @@ using namespace lv2c::ui;
 using namespace lv2c;
 using namespace pipedal;
 
+namespace
+{
+    // Routes lv2c log messages to the host's LV2_Log_Log.
+    class HostLogSink : public Lv2cLogSink
+    {
+    public:
+        HostLogSink(LV2_Log_Log *log, LV2_URID error, LV2_URID warning, LV2_URID note, LV2_URID trace)
+            : log(log), error(error), warning(warning), note(note), trace(trace)
+        {
+        }
+        virtual void Write(Lv2cLogLevel level, const char *message) override
+        {
+            LV2_URID type;
+            switch (level)
+            {
+            case Lv2cLogLevel::Error:
+                type = error;
+                break;
+            case Lv2cLogLevel::Warning:
+                type = warning;
+                break;
+            case Lv2cLogLevel::Info:
+                type = note;
+                break;
+            default:
+                type = trace;
+                break;
+            }
+            log->printf(log->handle, type, "%s", message);
+        }
+
+    private:
+        LV2_Log_Log *log;
+        LV2_URID error, warning, note, trace;
+    };
+}
+
 void Lv2UI::SetCreateWindowDefaults()
 {
     Lv2cCreateWindowParameters &params = this->createWindowParameters;
@@ -149,6 +187,9 @@ Lv2UI::Lv2UI(std::shared_ptr<Lv2PluginInfo> pluginInfo, const Lv2cCreateWindowPa
     this->bindingSites.resize(pluginInfo->ports().size());
     this->bindingSiteObserverHandles.resize(pluginInfo->ports().size());
     this->currentHostPortValues.resize(pluginInfo->ports().size());
+    this->pendingPortValues.resize(pluginInfo->ports().size());
+    this->portWritePending.resize(pluginInfo->ports().size());
+    this->pendingPortWrites.reserve(pluginInfo->ports().size());
 
     for (size_t i = 0; i < pluginInfo->ports().size(); ++i)
     {
@@ -163,7 +204,7 @@ Lv2UI::Lv2UI(std::shared_ptr<Lv2PluginInfo> pluginInfo, const Lv2cCreateWindowPa
             Lv2cBindingProperty<double> *pBinding = new Lv2cBindingProperty<double>();
             bindingSites[index] = pBinding;
             bindingSites[index]->set(port.default_value());
-            this->bindingSiteMap[port.symbol()] = bindingSites[index];
+            this->portSymbolMap[port.symbol()] = (uint32_t)index;
 
             currentHostPortValues[index] = port.default_value();
 
@@ -199,7 +240,12 @@ Lv2UI::~Lv2UI()
         delete bindingSites[i];
     }
     bindingSites.resize(0);
-    bindingSiteMap.clear();
+    portSymbolMap.clear();
+    if (hostLogSink)
+    {
+        RemoveLogSink(hostLogSink.get());
+        hostLogSink = nullptr;
+    }
 }
 
 // LV2 callback handlers.
@@ -242,6 +288,7 @@ bool Lv2UI::instantiate(
     this->forge = new LV2_Atom_Forge_();
 
     lv2_atom_forge_init(this->forge, this->map);
+    patchSetBuffer.resize(512);
 
     LV2_URID lv2ui_scaleFactor = this->GetUrid(LV2_UI__scaleFactor);
     if (options)
@@ -260,6 +307,11 @@ bool Lv2UI::instantiate(
         }
     }
     InitUrids();
+    if (this->log)
+    {
+        hostLogSink = std::make_unique<HostLogSink>(this->log, urids.log__Error, urids.log__Warning, urids.log__Note, urids.log__Trace);
+        AddLogSink(hostLogSink.get());
+    }
 
     bool parentWindowFound = false;
     for (int i = 0; features[i] != nullptr; ++i)
@@ -328,6 +380,7 @@ void Lv2UI::InitUrids()
     urids.atom__eventTransfer = GetUrid(LV2_ATOM__eventTransfer);
     urids.atom__Object = GetUrid(LV2_ATOM__Object);
     urids.atom__URID = GetUrid(LV2_ATOM__URID);
+    urids.atom__Vector = GetUrid(LV2_ATOM__Vector);
     urids.atom__Resource = GetUrid(LV2_ATOM__Resource);
     urids.atom__Blank = GetUrid(LV2_ATOM__Blank);
     urids.patch__Set = GetUrid(LV2_PATCH__Set);
@@ -359,12 +412,20 @@ void Lv2UI::ui_port_event(
                     const LV2_Atom_Object *object = (const LV2_Atom_Object *)atom;
                     if (object->body.otype == urids.patch__Set)
                     {
+                        // Walk the object body directly; cheaper than lv2_atom_object_get's varargs query.
                         const LV2_Atom *property = nullptr;
                         const LV2_Atom *value = nullptr;
-                        lv2_atom_object_get(object,
-                                            urids.patch__property, &property,
-                                            urids.patch__value, &value,
-                                            0);
+                        LV2_ATOM_OBJECT_FOREACH(object, prop)
+                        {
+                            if (prop->key == urids.patch__property)
+                            {
+                                property = &prop->value;
+                            }
+                            else if (prop->key == urids.patch__value)
+                            {
+                                value = &prop->value;
+                            }
+                        }
                         if (property != nullptr && property->type == urids.atom__URID &&  value != nullptr)
                         {
                             const LV2_Atom_URID *atomUrid = (const LV2_Atom_URID*)property;
@@ -408,10 +469,12 @@ int Lv2UI::ui_idle()
     {
         cairoWindow->PumpMessages(false);
     }
+    FlushPortWrites(false);
     return 0;
 }
 void Lv2UI::ui_delete()
 {
+    FlushPortWrites(true);
     CloseFileDialog();
 
     if (cairoWindow)
@@ -426,75 +489,43 @@ const std::string &Lv2UI::PluginUiUri() const { return pluginUiUri; }
 const std::string &Lv2UI::PluginUri() const { return pluginUri; }
 const std::string &Lv2UI::BundlePath() const { return bundlePath; }
 
-void Lv2UI::VLogError(const char *format, ...)
+void Lv2UI::VLog(Lv2cLogLevel level, const char *format, va_list args)
 {
-    if (this->log)
-    {
-        va_list args;
-        va_start(args, format);
-        log->vprintf(log->handle, urids.log__Error, format, args);
-        va_end(args);
-    }
-    else
+    if (!LogEnabled(level))
     {
-        printf("Error: ");
-        va_list args;
-        va_start(args, format);
-        vprintf(format, args);
-        va_end(args);
-        printf("\n");
+        return;
     }
+    char buffer[512];
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    Log(level, buffer, hostLogSink.get());
+}
+
+void Lv2UI::VLogError(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    VLog(Lv2cLogLevel::Error, format, args);
+    va_end(args);
 }
 void Lv2UI::LogError(const char *message)
 {
-    if (this->log)
-    {
-        log->printf(log->handle, urids.log__Error, "%s", message);
-    }
-    else
-    {
-        printf("Error: ");
-        printf("%s", message);
-        printf("\n");
-    }
+    Log(Lv2cLogLevel::Error, message, hostLogSink.get());
 }
 
 void Lv2UI::LogError(const std::string &message)
 {
     LogError(message.c_str());
 }
-
 void Lv2UI::VLogNote(const char *format, ...)
 {
-    if (this->log)
-    {
-        va_list args;
-        va_start(args, format);
-        log->vprintf(log->handle, urids.log__Note, format, args);
-        va_end(args);
-    }
-    else
-    {
-        printf("Note: ");
-        va_list args;
-        va_start(args, format);
-        vprintf(format, args);
-        va_end(args);
-        printf("\n");
-    }
+    va_list args;
+    va_start(args, format);
+    VLog(Lv2cLogLevel::Info, format, args);
+    va_end(args);
 }
 void Lv2UI::LogNote(const char *message)
 {
-    if (this->log)
-    {
-        log->printf(log->handle, urids.log__Note, "%s", message);
-    }
-    else
-    {
-        printf("Note: ");
-        printf("%s", message);
-        printf("\n");
-    }
+    Log(Lv2cLogLevel::Info, message, hostLogSink.get());
 }
 
 void Lv2UI::LogNote(const std::string &message)
@@ -503,35 +534,14 @@ void Lv2UI::LogNote(const std::string &message)
 }
 void Lv2UI::VLogTrace(const char *format, ...)
 {
-    if (this->log)
-    {
-        va_list args;
-        va_start(args, format);
-        log->vprintf(log->handle, urids.log__Trace, format, args);
-        va_end(args);
-    }
-    else
-    {
-        printf("Trace: ");
-        va_list args;
-        va_start(args, format);
-        vprintf(format, args);
-        va_end(args);
-        printf("\n");
-    }
+    va_list args;
+    va_start(args, format);
+    VLog(Lv2cLogLevel::Trace, format, args);
+    va_end(args);
 }
 void Lv2UI::LogTrace(const char *message)
 {
-    if (this->log)
-    {
-        log->printf(log->handle, urids.log__Trace, "%s", message);
-    }
-    else
-    {
-        printf("Trace: ");
-        printf("%s", message);
-        printf("\n");
-    }
+    Log(Lv2cLogLevel::Trace, message, hostLogSink.get());
 }
 
 void Lv2UI::LogTrace(const std::string &message)
@@ -540,35 +550,14 @@ void Lv2UI::LogTrace(const std::string &message)
 }
 void Lv2UI::VLogWarning(const char *format, ...)
 {
-    if (this->log)
-    {
-        va_list args;
-        va_start(args, format);
-        log->vprintf(log->handle, urids.log__Warning, format, args);
-        va_end(args);
-    }
-    else
-    {
-        printf("Warning: ");
-        va_list args;
-        va_start(args, format);
-        vprintf(format, args);
-        va_end(args);
-        printf("\n");
-    }
+    va_list args;
+    va_start(args, format);
+    VLog(Lv2cLogLevel::Warning, format, args);
+    va_end(args);
 }
 void Lv2UI::LogWarning(const char *message)
 {
-    if (this->log)
-    {
-        log->printf(log->handle, urids.log__Warning, "%s", message);
-    }
-    else
-    {
-        printf("Warning: ");
-        printf("%s", message);
-        printf("\n");
-    }
+    Log(Lv2cLogLevel::Warning, message, hostLogSink.get());
 }
 
 void Lv2UI::LogWarning(const std::string &message)
@@ -590,31 +579,67 @@ const char *Lv2UI::UridToString(LV2_URID urid)
     return "#not available.";
 }
 
-Lv2cBindingProperty<double> &Lv2UI::GetControlProperty(const std::string &key)
+Lv2PortKey Lv2UI::GetPortKey(std::string_view symbol) const
 {
-    auto f = bindingSiteMap.find(key);
-    if (f == bindingSiteMap.end())
+    auto f = portSymbolMap.find(symbol);
+    if (f == portSymbolMap.end())
+    {
+        return Lv2PortKey();
+    }
+    return Lv2PortKey(f->second);
+}
+
+Lv2cBindingProperty<double> &Lv2UI::GetControlProperty(std::string_view key)
+{
+    Lv2PortKey portKey = GetPortKey(key);
+    if (!portKey)
     {
         throw std::invalid_argument("Key not found.");
     }
-    return *(f->second);
+    return GetControlProperty(portKey);
 }
-const Lv2cBindingProperty<double> &Lv2UI::GetControlProperty(const std::string &key) const
+const Lv2cBindingProperty<double> &Lv2UI::GetControlProperty(std::string_view key) const
 {
-    auto f = bindingSiteMap.find(key);
-    if (f == bindingSiteMap.end())
+    Lv2PortKey portKey = GetPortKey(key);
+    if (!portKey)
     {
         throw std::invalid_argument("Key not found.");
     }
-    return *(f->second);
+    return GetControlProperty(portKey);
+}
+
+Lv2cBindingProperty<double> &Lv2UI::GetControlProperty(uint32_t portIndex)
+{
+    if (portIndex >= bindingSites.size() || bindingSites[portIndex] == nullptr)
+    {
+        throw std::invalid_argument("Not a control port.");
+    }
+    return *(bindingSites[portIndex]);
+}
+const Lv2cBindingProperty<double> &Lv2UI::GetControlProperty(uint32_t portIndex) const
+{
+    if (portIndex >= bindingSites.size() || bindingSites[portIndex] == nullptr)
+    {
+        throw std::invalid_argument("Not a control port.");
+    }
+    return *(bindingSites[portIndex]);
 }
 
-Lv2UI &Lv2UI::SetControlValue(const std::string &key, double value)
+Lv2UI &Lv2UI::SetControlValue(std::string_view key, double value)
 {
     GetControlProperty(key).set(value);
     return *this;
 }
-double Lv2UI::GetControlValue(const std::string &key) const
+double Lv2UI::GetControlValue(std::string_view key) const
+{
+    return GetControlProperty(key).get();
+}
+Lv2UI &Lv2UI::SetControlValue(Lv2PortKey key, double value)
+{
+    GetControlProperty(key).set(value);
+    return *this;
+}
+double Lv2UI::GetControlValue(Lv2PortKey key) const
 {
     return GetControlProperty(key).get();
 }
@@ -727,8 +752,8 @@ void Lv2UI::AddRenderControls(Lv2cContainerElement::ptr container)
                     container->AddChild(
                         RenderStereoControl(
                             label,
-                            GetControlProperty(port.symbol()), port,
-                            GetControlProperty(rightPort.symbol()), rightPort));
+                            GetControlProperty(port.index()), port,
+                            GetControlProperty(rightPort.index()), rightPort));
 
                     // skip the right control
                     ++i;
@@ -766,7 +791,7 @@ void Lv2UI::AddRenderControls(Lv2cContainerElement::ptr container)
                     groupIndex->push_back(port.index());
                     portGroup->AddChild(
                         RenderControl(
-                            GetControlProperty(port.symbol()),
+                            GetControlProperty(port.index()),
                             port));
                 }
             }
@@ -775,7 +800,7 @@ void Lv2UI::AddRenderControls(Lv2cContainerElement::ptr container)
                 mainControlIndex.push_back(port.index());
                 container->AddChild(
                     RenderControl(
-                        GetControlProperty(port.symbol()),
+                        GetControlProperty(port.index()),
                         port));
             }
         }
@@ -853,9 +878,50 @@ Lv2cElement::ptr Lv2UI::RenderControl(Lv2cBindingProperty<double> &value, const
 
 void Lv2UI::OnPortValueChanged(int32_t portIndex, double value)
 {
-    float floatValue = (float)value;
     if (this->controller != nullptr)
     {
+        // Intermediate values (e.g. while dragging a dial) overwrite each other; the
+        // last value is written to the host by FlushPortWrites().
+        pendingPortValues[portIndex] = (float)value;
+        if (!portWritePending[portIndex])
+        {
+            portWritePending[portIndex] = true;
+            pendingPortWrites.push_back((uint32_t)portIndex);
+        }
+    }
+}
+
+Lv2UI &Lv2UI::PortWriteInterval(std::chrono::milliseconds value)
+{
+    portWriteInterval = value;
+    return *this;
+}
+std::chrono::milliseconds Lv2UI::PortWriteInterval() const
+{
+    return portWriteInterval;
+}
+
+void Lv2UI::FlushPortWrites(bool force)
+{
+    if (pendingPortWrites.empty())
+    {
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (!force && portWriteInterval.count() != 0 && now - lastPortWriteTime < portWriteInterval)
+    {
+        // rate-limited, but never hold back the final value once the mouse button is released.
+        if (cairoWindow && cairoWindow->Capture() != nullptr)
+        {
+            return;
+        }
+    }
+    lastPortWriteTime = now;
+
+    for (uint32_t portIndex : pendingPortWrites)
+    {
+        portWritePending[portIndex] = false;
+        float floatValue = pendingPortValues[portIndex];
         if (floatValue != this->currentHostPortValues[portIndex])
         {
             this->currentHostPortValues[portIndex] = floatValue;
@@ -867,6 +933,7 @@ void Lv2UI::OnPortValueChanged(int32_t portIndex, double value)
                 &floatValue);
         }
     }
+    pendingPortWrites.clear();
 }
 
 Lv2cTheme::ptr Lv2UI::Theme()
@@ -920,12 +987,73 @@ void Lv2UI::OnPatchPropertyReceived(LV2_URID type, const uint8_t *data)
         }
     }
 
+    patchPropertyListeners.Dispatch(type, atom);
 
     PatchPropertyEventArgs eventArgs { type,data};
     
     OnPatchProperty.Fire(eventArgs);
 }
 
+EventHandle Lv2UI::AddPatchPropertyListener(LV2_URID property, PatchPropertyListener &&listener)
+{
+    return patchPropertyListeners.Add(property, std::move(listener));
+}
+
+EventHandle Lv2UI::AddFloatVectorPropertyListener(LV2_URID property, std::function<void(std::span<const float> values)> &&listener)
+{
+    return AddPatchPropertyListener(
+        property,
+        [this, listener = std::move(listener)](const LV2_Atom *value)
+        {
+            // ignore malformed vectors: the body must be present before its child type can be read.
+            if (value->type != urids.atom__Vector || value->size < sizeof(LV2_Atom_Vector_Body))
+            {
+                return;
+            }
+            const LV2_Atom_Vector *atomVector = (const LV2_Atom_Vector *)value;
+            if (atomVector->body.child_type == urids.atom__Float
+                && atomVector->body.child_size == sizeof(float))
+            {
+                size_t count = (atomVector->atom.size - sizeof(LV2_Atom_Vector_Body)) / sizeof(float);
+                const float *values = (const float *)LV2_ATOM_CONTENTS(LV2_Atom_Vector, atomVector);
+                listener(std::span<const float>(values, count));
+            }
+        });
+}
+
+EventHandle Lv2UI::AddFloatPropertyListener(LV2_URID property, std::function<void(float value)> &&listener)
+{
+    return AddPatchPropertyListener(
+        property,
+        [this, listener = std::move(listener)](const LV2_Atom *value)
+        {
+            if (value->type == urids.atom__Float && value->size >= sizeof(float))
+            {
+                listener(((const LV2_Atom_Float *)value)->body);
+            }
+        });
+}
+
+EventHandle Lv2UI::AddStringPropertyListener(LV2_URID property, std::function<void(std::string_view value)> &&listener)
+{
+    return AddPatchPropertyListener(
+        property,
+        [this, listener = std::move(listener)](const LV2_Atom *value)
+        {
+            if ((value->type == urids.atom__String || value->type == urids.atom__Path) && value->size != 0)
+            {
+                const char *text = (const char *)LV2_ATOM_BODY_CONST(value);
+                // atom:String size includes the null terminator.
+                listener(std::string_view(text, strnlen(text, value->size)));
+            }
+        });
+}
+
+bool Lv2UI::RemovePatchPropertyListener(EventHandle handle)
+{
+    return patchPropertyListeners.Remove(handle);
+}
+
 void Lv2UI::RequestPatchProperty(LV2_URID property)
 {
     lv2_atom_forge_set_buffer(forge, patchRequestBuffer, sizeof(patchRequestBuffer));
@@ -949,18 +1077,23 @@ void Lv2UI::RequestPatchProperty(LV2_URID property)
 
 }
 
-void Lv2UI::WritePatchProperty(LV2_URID property,const LV2_Atom *value)
+void Lv2UI::WritePatchSet(LV2_URID property, const LV2_Atom *value, const std::string *stringValue)
 {
+    // deferred control values must reach the host before this message, so that the host sees writes in the order they were made.
+    FlushPortWrites(true);
+
+    size_t valueSize = value ? value->size : stringValue->length() + 1;
     size_t messageSize = 
-        value->size + (sizeof(LV2_Atom) 
+        valueSize + (sizeof(LV2_Atom) 
         + sizeof(LV2_Atom_Object) + sizeof(LV2_Atom_Property)*2 
         + sizeof(LV2_Atom_URID)+20+4);
-    
 
-    std::vector<uint8_t> buffer;
-    buffer.resize(messageSize);
-
-    lv2_atom_forge_set_buffer(forge, &buffer[0], buffer.size());
+    // reused across messages; only grows.
+    if (patchSetBuffer.size() < messageSize)
+    {
+        patchSetBuffer.resize(std::max(messageSize, patchSetBuffer.size() * 2));
+    }
+    lv2_atom_forge_set_buffer(forge, patchSetBuffer.data(), patchSetBuffer.size());
 
 
 	LV2_Atom_Forge_Frame objectFrame;
@@ -971,14 +1104,21 @@ void Lv2UI::WritePatchProperty(LV2_URID property,const LV2_Atom *value)
 	lv2_atom_forge_urid(forge, property);
 
 	lv2_atom_forge_key(forge, urids.patch__value);
-    lv2_atom_forge_primitive(forge,value);
+    if (value)
+    {
+        lv2_atom_forge_primitive(forge,value);
+    }
+    else
+    {
+        lv2_atom_forge_string(forge, stringValue->c_str(), (uint32_t)stringValue->length());
+    }
 
 	lv2_atom_forge_pop(forge, &objectFrame);
 
 
-    LV2_Atom *msg = (LV2_Atom*)&(buffer[0]);
+    LV2_Atom *msg = (LV2_Atom*)patchSetBuffer.data();
 
-    assert(msg->size + sizeof(LV2_Atom) <= buffer.size());
+    assert(msg->size + sizeof(LV2_Atom) <= patchSetBuffer.size());
 
     if (inputAtomPort == (uint32_t)-1)
     {
@@ -990,7 +1130,11 @@ void Lv2UI::WritePatchProperty(LV2_URID property,const LV2_Atom *value)
             urids.atom__eventTransfer,
             msg);
     }
+}
 
+void Lv2UI::WritePatchProperty(LV2_URID property,const LV2_Atom *value)
+{
+    WritePatchSet(property, value, nullptr);
 }
 void Lv2UI::WritePatchProperty(LV2_URID property,bool value)
 {
@@ -1011,22 +1155,7 @@ void Lv2UI::WritePatchProperty(LV2_URID property,float value)
 }
 void Lv2UI::WritePatchProperty(LV2_URID property,const std::string& value)
 {
-    size_t atomSize = sizeof(LV2_Atom) + value.length() + 1;
-    std::vector<uint8_t> atomBuffer;
-    atomBuffer.resize(atomSize);
-    uint8_t *pBuffer = &(atomBuffer[0]);
-    LV2_Atom_String *atom = (LV2_Atom_String*)pBuffer;
-    atom->atom.type = urids.atom__String;
-    atom->atom.size = value.length()+1;
-    char*pAtomString = (char*)(pBuffer + sizeof(LV2_Atom));
-
-    // github build generates a warning here, even though it's correct.
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Warray-bounds"
-// xxx check this with a debugger. why does github gcc dislike this?!
-    strcpy(pAtomString,value.c_str());
-#pragma GCC diagnostic pop    
-    WritePatchProperty(property,(const LV2_Atom*)pBuffer);
+    WritePatchSet(property, nullptr, &value);
 }
 
 Lv2cElement::ptr Lv2UI::RenderFileControl(const UiFileProperty &fileProperty)
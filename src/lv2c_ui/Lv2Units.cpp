@@ -71,9 +71,10 @@ std::map<Lv2Units,std::string> unitsToStringMap =
 static const std::string emptyString;
 const std::string& lv2c::ui::UnitsToString(Lv2Units units)
 {
-    if (unitsToStringMap.find(units) != unitsToStringMap.end())
+    auto f = unitsToStringMap.find(units);
+    if (f != unitsToStringMap.end())
     {
-        return unitsToStringMap[units];
+        return f->second;
     } else {
         return emptyString;
     }
@@ -19,6 +19,7 @@
 
 #pragma once
 #include "lv2c/Lv2cElement.hpp"
+#include "lv2c/Lv2cDrawingContext.hpp"
 #include "lv2c_ui/PiPedalUI.hpp"
 #include "lv2c_ui/Lv2UI.hpp"
 
@@ -44,20 +45,31 @@ namespace lv2c::ui {
     private:
         void PreComputeGridXs();
         void DrawTicks(Lv2cDrawingContext &dc);
+        void DrawGridLayer(Lv2cDrawingContext &dc);
+        void DrawCurve(Lv2cDrawingContext &dc);
         EventHandle propertyEventHandle;
         struct Urids {
             LV2_URID propertyUrid;
-            LV2_URID atom__Vector;
-            LV2_URID atom__Float;
         };
         Urids urids;
         void InitUrids();
 
-        void OnValuesChanged(const void*value);
+        void OnValuesChanged(std::span<const float> values);
         Lv2UI*lv2UI = nullptr;
         UiFrequencyPlot frequencyPlot;
         std::vector<float> values;
+        std::vector<float> dbValues;
         std::vector<double> majorGridXs;
         std::vector<double> minorGridXs;
+
+        // The grid, rendered at device resolution. Rebuilt when the size, axes or theme colors change.
+        Lv2cSurface gridLayer;
+        Lv2cRectangle gridLayerBounds;
+        Lv2cSize gridLayerDeviceSize;
+        Lv2cColor gridLayerColor;
+
+        // The curve, rebuilt when the values, size or axes change.
+        Lv2cPath curvePath;
+        Lv2cSize curvePathSize;
     };
 }
\ No newline at end of file
@@ -0,0 +1,68 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+
+#include <lv2/atom/atom.h>
+#include <lv2/urid/urid.h>
+#include "lv2c/Lv2cTypes.hpp"
+
+namespace lv2c::ui
+{
+    /// @brief Listeners for patch:Set property values, looked up by property URID.
+    ///
+    /// Listeners may be added or removed while a value is being dispatched, including
+    /// by the listener that is currently being called. Removed listeners are not called 
+    /// again, but are only destroyed once dispatch completes. Listeners added during 
+    /// dispatch are not called until the next value is dispatched.
+    class Lv2PatchPropertyListeners
+    {
+    public:
+        using Listener = std::function<void(const LV2_Atom *value)>;
+
+        EventHandle Add(LV2_URID property, Listener &&listener);
+        bool Remove(EventHandle handle);
+        void Dispatch(LV2_URID property, const LV2_Atom *value);
+
+        /// @brief The number of listeners that have not been removed.
+        size_t size() const { return listenerProperties.size(); }
+
+    private:
+        void Compact();
+
+        struct Entry
+        {
+            uint64_t handle;
+            Listener listener;
+            bool removed = false;
+        };
+        // a deque, so that references to entries stay valid when listeners are added during dispatch.
+        std::unordered_map<LV2_URID, std::deque<Entry>> listeners;
+        std::unordered_map<uint64_t, LV2_URID> listenerProperties;
+        bool dispatching = false;
+        bool removedDuringDispatch = false;
+    };
+}
@@ -0,0 +1,102 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "lv2c_ui/Lv2Units.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+namespace lv2c::ui
+{
+    // Constant-initialized port metadata, emitted by generate_lv2c_plugin_info alongside the
+    // generated Lv2PluginInfo class. Lives in static storage, so it can be used at compile time,
+    // and at runtime without allocation.
+
+    /// @brief FNV-1a hash of a port symbol.
+    constexpr uint64_t Lv2SymbolHash(std::string_view symbol)
+    {
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (char c : symbol)
+        {
+            hash ^= (uint8_t)c;
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    struct Lv2ScalePointEntry
+    {
+        float value;
+        const char *label;
+    };
+
+    struct Lv2PortTableEntry
+    {
+        uint32_t index;
+        const char *symbol;
+        uint64_t symbolHash;
+        const char *name;
+        float min_value;
+        float max_value;
+        float default_value;
+        Lv2Units units;
+        int range_steps;
+
+        bool is_input;
+        bool is_output;
+        bool is_control_port;
+        bool is_audio_port;
+        bool is_atom_port;
+        bool is_logarithmic;
+        bool integer_property;
+        bool enumeration_property;
+        bool toggled_property;
+        bool trigger;
+        bool not_on_gui;
+
+        std::span<const Lv2ScalePointEntry> scale_points;
+    };
+
+    /// @brief Find a port by symbol.
+    /// @returns The matching entry, or nullptr if there isn't one.
+    constexpr const Lv2PortTableEntry *FindPort(std::span<const Lv2PortTableEntry> ports, std::string_view symbol)
+    {
+        uint64_t hash = Lv2SymbolHash(symbol);
+        for (const auto &port : ports)
+        {
+            if (port.symbolHash == hash && symbol == port.symbol)
+            {
+                return &port;
+            }
+        }
+        return nullptr;
+    }
+
+    /// @brief Find a port's index by symbol.
+    /// @returns The port index, or (uint32_t)-1 if there isn't one.
+    constexpr uint32_t FindPortIndex(std::span<const Lv2PortTableEntry> ports, std::string_view symbol)
+    {
+        const Lv2PortTableEntry *port = FindPort(ports, symbol);
+        return port ? port->index : (uint32_t)-1;
+    }
+}
@@ -0,0 +1,156 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+#include "lv2c/Lv2cElement.hpp"
+#include "lv2c/Lv2cBindingProperty.hpp"
+#include "lv2c_ui/Lv2UI.hpp"
+#include <vector>
+#include <cstdint>
+
+namespace lv2c::ui {
+
+    enum class Lv2SpectrumMode {
+        /// Frames are FFT magnitudes (linear amplitude), from 0Hz to SampleRate/2, displayed on a log-frequency axis.
+        Spectrum,
+        /// Frames are audio samples in [-1..1], displayed on a linear time axis.
+        Waveform
+    };
+
+    /// @brief Reduces spectrum or waveform frames to one value per pixel column.
+    ///
+    /// Buffers are allocated when the layout changes. Reducing a frame does not allocate.
+    class Lv2SpectrumColumns {
+    public:
+        /// @brief Configure for spectrum frames.
+        /// @param columns Number of output columns.
+        /// @param binCount Number of FFT bins in each frame (including the 0Hz bin).
+        /// @param sampleRate The sample rate of the analyzed audio.
+        /// @param minFrequency Frequency at the left edge of the first column.
+        /// @param maxFrequency Frequency at the right edge of the last column.
+        void SpectrumLayout(size_t columns, size_t binCount, double sampleRate, double minFrequency, double maxFrequency);
+
+        /// @brief Configure for waveform frames.
+        /// @param columns Number of output columns.
+        /// @param sampleCount Number of samples in each frame.
+        void WaveformLayout(size_t columns, size_t sampleCount);
+
+        Lv2SpectrumMode Mode() const { return mode; }
+        size_t Columns() const { return max.size(); }
+        /// @brief The number of values expected in each frame.
+        size_t InputSize() const { return inputSize; }
+
+        /// @brief Reduce a frame of InputSize() values.
+        ///
+        /// In Spectrum mode, Max() receives the peak magnitude of the bins in each column,
+        /// interpolating between bins where a column is narrower than a bin. In Waveform mode,
+        /// Min() and Max() receive the extremes of the samples in each column.
+        void Reduce(const float *values);
+
+        const std::vector<float> &Min() const { return min; }
+        const std::vector<float> &Max() const { return max; }
+
+    private:
+        Lv2SpectrumMode mode = Lv2SpectrumMode::Spectrum;
+        size_t inputSize = 0;
+        // Columns cover input[start..end). If start==end, the column interpolates input[start] and input[start+1] by fraction.
+        std::vector<uint32_t> start;
+        std::vector<uint32_t> end;
+        std::vector<float> fraction;
+        std::vector<float> min;
+        std::vector<float> max;
+    };
+
+    /// @brief Displays a real-time spectrum or waveform.
+    ///
+    /// Frames can be supplied at any rate, either by calling SetValues(), or 
+    /// by the plugin, as an atom:Vector of atom:Float values in a patch property. 
+    /// Only the most recent frame is processed, once per animation frame, so the element 
+    /// redraws at most once per display frame regardless of the message rate.
+    ///
+    /// In Spectrum mode, a peak line falls back toward the current level at PeakDecay
+    /// dB per second.
+    class Lv2SpectrumElement: public Lv2cElement {
+    public:
+        using self=Lv2SpectrumElement;
+        using super=Lv2cElement;
+        using ptr = std::shared_ptr<self>;
+        static ptr Create() { return std::make_shared<self>(); }
+
+        /// @brief Create an element that receives frames from a patch property.
+        /// @param lv2UI The plugin UI.
+        /// @param patchProperty The URI of the patch property.
+        static ptr Create(Lv2UI*lv2UI,const std::string &patchProperty) {
+            return std::make_shared<self>(lv2UI,patchProperty);
+        }
+
+        Lv2SpectrumElement();
+        Lv2SpectrumElement(Lv2UI*lv2UI,const std::string &patchProperty);
+
+        BINDING_PROPERTY(Mode,Lv2SpectrumMode,Lv2SpectrumMode::Spectrum)
+        BINDING_PROPERTY(SampleRate,double,48000.0)
+        BINDING_PROPERTY(MinFrequency,double,20.0)
+        BINDING_PROPERTY(MaxFrequency,double,20000.0)
+        BINDING_PROPERTY(MinDb,double,-90.0)
+        BINDING_PROPERTY(MaxDb,double,0.0)
+        /// @brief Rate at which peaks fall, in dB per second.
+        BINDING_PROPERTY(PeakDecay,double,20.0)
+
+        /// @brief Supply a frame.
+        void SetValues(const float *values, size_t count);
+
+    protected:
+        virtual bool WillDraw() const override;
+        virtual void OnMount() override;
+        virtual void OnUnmount() override;
+        virtual void OnDraw(Lv2cDrawingContext &dc) override;
+
+    private:
+        void OnLayoutPropertyChanged(double value);
+        void OnModePropertyChanged(Lv2SpectrumMode value);
+
+        void RequestFrame();
+        void OnAnimationFrame(const animation_clock_time_point_t &now);
+        void UpdateLayout(size_t inputSize);
+        void UpdateColumns();
+
+        Lv2UI*lv2UI = nullptr;
+        EventHandle propertyEventHandle;
+        LV2_URID propertyUrid = 0;
+
+        AnimationHandle animationHandle;
+        animation_clock_time_point_t lastFrameTime;
+        bool hasLastFrameTime = false;
+
+        // The most recently received frame, not yet processed.
+        std::vector<float> pendingValues;
+        size_t pendingCount = 0;
+        bool framePending = false;
+
+        Lv2SpectrumColumns columns;
+        size_t columnCount = 0;
+        bool columnsValid = false;
+
+        // Per-column display values (dB in Spectrum mode, samples in Waveform mode).
+        std::vector<float> levels;
+        std::vector<float> peaks;
+        std::vector<float> minLevels;
+        bool peaksActive = false;
+    };
+}
@@ -21,6 +21,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once 
 
 #include "lv2c/Lv2cValueElement.hpp"
+#include "lv2c/Lv2cDrawingContext.hpp"
+#include <string>
 
 
 // forward declarations
@@ -30,10 +32,6 @@ typedef struct _PangoFontMap PangoFontMap;
 typedef struct _PangoFontDescription PangoFontDescription;
 
 
-namespace lv2c {
-    class Lv2cDrawingContext;
-}
-
 namespace lv2c::ui {
 
     class Lv2TunerElement : public Lv2cValueElement {
@@ -52,14 +50,35 @@ namespace lv2c::ui {
     protected:
         virtual bool WillDraw() const override { return true; }
         virtual void OnMount() override;
+        virtual void OnUnmount() override;
         virtual void OnValueChanged(double value) override;
         virtual void OnDraw(Lv2cDrawingContext &dc) override;
     private:
+        double MidiNote();
         void DrawText(Lv2cDrawingContext&dc, double midiNote);
-        void DrawDial(Lv2cDrawingContext&c, double midiNote);
+        void DrawDialLayer(Lv2cDrawingContext&dc);
+        void DrawDialScale(Lv2cDrawingContext&dc);
+        void DrawNeedle(Lv2cDrawingContext&c, double midiNote);
+        void UpdateText(double midiNote);
         void PreparePangoContext();
         void FreePangoContext();
-        PangoLayout *pangoLayout = nullptr;
+
+        // Background and dial scale, rendered at device resolution. Rebuilt when the size or style patterns change.
+        Lv2cSurface dialLayer;
+        Lv2cRectangle dialLayerBounds;
+        Lv2cSize dialLayerDeviceSize;
+        Lv2cPattern dialLayerBackground;
+        Lv2cPattern dialLayerColor;
+
+        // Shaped text. Layouts are only re-shaped when the displayed text changes.
+        static constexpr int NO_VALUE = 1000;      // displayed as "−−"
+        static constexpr int INVALID_TEXT = -1000; // not shaped yet
+        PangoLayout *noteLayout = nullptr;
+        PangoLayout *centsLayout = nullptr;
+        int displayedNote = INVALID_TEXT;
+        int displayedCents = INVALID_TEXT;
+        Lv2cSize noteTextSize;
+        Lv2cSize centsTextSize;
     };
 
 }
\ No newline at end of file
@@ -23,14 +23,23 @@
 
 #include <concepts>
 #include <memory>
+#include <cstdarg>
+#include <chrono>
+#include <vector>
+#include <span>
+#include <string_view>
+#include <functional>
+#include <type_traits>
 
 #include "Lv2UI_NativeCallbacks.hpp"
 #include "lv2c/IcuString.hpp"
 #include "Lv2PluginInfo.hpp"
+#include "Lv2PatchPropertyListeners.hpp"
 #include "lv2c/Lv2cElement.hpp"
 #include "lv2c/Lv2cContainerElement.hpp"
 #include "lv2c/Lv2cBindingProperty.hpp"
 #include "lv2c/Lv2cWindow.hpp"
+#include "lv2c/Lv2cLog.hpp"
 
 #include <unordered_map>
 
@@ -45,6 +54,28 @@ namespace lv2c
 }
 namespace lv2c::ui
 {
+    /// @brief A control port resolved by symbol.
+    ///
+    /// Resolve once with Lv2UI::GetPortKey(), then use the key in place of the symbol
+    /// to access the control without hashing a string on every call.
+    class Lv2PortKey
+    {
+    public:
+        static constexpr uint32_t INVALID_INDEX = (uint32_t)-1;
+
+        Lv2PortKey() {}
+        explicit Lv2PortKey(uint32_t index) : index(index) {}
+
+        uint32_t Index() const { return index; }
+        bool IsValid() const { return index != INVALID_INDEX; }
+        explicit operator bool() const { return IsValid(); }
+
+        bool operator==(const Lv2PortKey &other) const = default;
+
+    private:
+        uint32_t index = INVALID_INDEX;
+    };
+
     class Lv2PortViewFactory;
     class Lv2FileDialog;
     
@@ -94,8 +125,14 @@ namespace lv2c::ui
         virtual Lv2cContainerElement::ptr Render();
         virtual Lv2cContainerElement::ptr RenderControls();
         virtual Lv2cElement::ptr RenderFileControl(const UiFileProperty &fileProperty);
-        Lv2UI&SetControlValue(const std::string&key, double value);
-        double GetControlValue(const std::string&key) const;
+        Lv2UI&SetControlValue(std::string_view key, double value);
+        double GetControlValue(std::string_view key) const;
+        Lv2UI&SetControlValue(Lv2PortKey key, double value);
+        double GetControlValue(Lv2PortKey key) const;
+
+        /// @brief Resolve a control port symbol.
+        /// @returns The key, or an invalid key if there is no control port with that symbol.
+        Lv2PortKey GetPortKey(std::string_view symbol) const;
 
         Lv2cWindow::ptr Window() { return cairoWindow; }
 
@@ -107,13 +144,63 @@ namespace lv2c::ui
         };
         Lv2cEvent<PatchPropertyEventArgs> OnPatchProperty;
 
+        /// @brief Receives the patch:value atom of a patch:Set message.
+        using PatchPropertyListener = Lv2PatchPropertyListeners::Listener;
+
+        /// @brief Listen for patch:Set messages for a single property.
+        ///
+        /// Unlike OnPatchProperty, listeners are looked up by property URID, so only 
+        /// listeners for the received property are called.
+        /// @returns A handle to pass to RemovePatchPropertyListener.
+        EventHandle AddPatchPropertyListener(LV2_URID property, PatchPropertyListener &&listener);
+        /// @brief Listen for atom:Vector of atom:Float values. The span refers to the received atom, and is only valid for the duration of the call.
+        EventHandle AddFloatVectorPropertyListener(LV2_URID property, std::function<void(std::span<const float> values)> &&listener);
+        /// @brief Listen for atom:Float values.
+        EventHandle AddFloatPropertyListener(LV2_URID property, std::function<void(float value)> &&listener);
+        /// @brief Listen for atom:String or atom:Path values. The string_view refers to the received atom, and is only valid for the duration of the call.
+        EventHandle AddStringPropertyListener(LV2_URID property, std::function<void(std::string_view value)> &&listener);
+        bool RemovePatchPropertyListener(EventHandle handle);
+
         void WritePatchProperty(LV2_URID property,const LV2_Atom *value);
         void WritePatchProperty(LV2_URID property,bool value);
         void WritePatchProperty(LV2_URID property,float value);
         void WritePatchProperty(LV2_URID property,const std::string& value);
 
-        Lv2cBindingProperty<double>&GetControlProperty(const std::string&key);
-        const Lv2cBindingProperty<double>&GetControlProperty(const std::string&key) const;
+        /// @brief Minimum interval between control port writes to the host.
+        ///
+        /// Control values are aggregated per port and written once per ui_idle() call, 
+        /// which sends only the last value of a drag to the host each frame. A non-zero 
+        /// interval further limits the write rate while the mouse is captured. The final 
+        /// value is always sent once the mouse button is released. Pending values are also 
+        /// flushed before a patch:Set is written, so the two are never reordered. Default: 0.
+        Lv2UI &PortWriteInterval(std::chrono::milliseconds value);
+        std::chrono::milliseconds PortWriteInterval() const;
+
+        /// @brief Write pending control port values to the host.
+        /// @param force If true, ignore PortWriteInterval().
+        void FlushPortWrites(bool force = true);
+
+        Lv2cBindingProperty<double>&GetControlProperty(std::string_view key);
+        const Lv2cBindingProperty<double>&GetControlProperty(std::string_view key) const;
+        Lv2cBindingProperty<double>&GetControlProperty(Lv2PortKey key) { return GetControlProperty(key.Index()); }
+        const Lv2cBindingProperty<double>&GetControlProperty(Lv2PortKey key) const { return GetControlProperty(key.Index()); }
+        /// @brief Get a control by port index, without a symbol lookup.
+        Lv2cBindingProperty<double>&GetControlProperty(uint32_t portIndex);
+        const Lv2cBindingProperty<double>&GetControlProperty(uint32_t portIndex) const;
+
+        /// @brief Get a control by a generated PortIndex enum value (see generate_lv2c_plugin_info).
+        template <typename PORT_INDEX>
+            requires std::is_enum_v<PORT_INDEX>
+        Lv2cBindingProperty<double> &GetControlProperty(PORT_INDEX portIndex)
+        {
+            return GetControlProperty((uint32_t)portIndex);
+        }
+        template <typename PORT_INDEX>
+            requires std::is_enum_v<PORT_INDEX>
+        const Lv2cBindingProperty<double> &GetControlProperty(PORT_INDEX portIndex) const
+        {
+            return GetControlProperty((uint32_t)portIndex);
+        }
 
 
         virtual void AddRenderControls(Lv2cContainerElement::ptr container);
@@ -163,11 +250,22 @@ namespace lv2c::ui
         std::vector<Lv2cBindingProperty<double> *> bindingSites;
         std::vector<Observable<double>::handle_t> bindingSiteObserverHandles;
         std::vector<double> currentHostPortValues;
+        std::vector<float> pendingPortValues;
+        std::vector<bool> portWritePending;
+        std::vector<uint32_t> pendingPortWrites;
+        std::chrono::milliseconds portWriteInterval{0};
+        std::chrono::steady_clock::time_point lastPortWriteTime;
 
         std::map<LV2_URID,std::shared_ptr<Lv2cBindingProperty<std::string>>> filePropertyBindingSites;
 
         void OnPortValueChanged(int32_t portIndex, double value);
-        std::unordered_map<std::string,Lv2cBindingProperty<double>*> bindingSiteMap;
+        // heterogeneous lookup, so that string_view keys don't construct a std::string.
+        struct SymbolHash
+        {
+            using is_transparent = void;
+            size_t operator()(std::string_view value) const { return std::hash<std::string_view>()(value); }
+        };
+        std::unordered_map<std::string, uint32_t, SymbolHash, std::equal_to<>> portSymbolMap;
 
         std::shared_ptr<Lv2PluginInfo> pluginInfo;
         void InitUrids();
@@ -183,6 +281,7 @@ namespace lv2c::ui
             LV2_URID atom__String;
             LV2_URID atom__Path;
             LV2_URID atom__URID;
+            LV2_URID atom__Vector;
             LV2_URID atom__Resource;
             LV2_URID atom__Blank;
             LV2_URID atom__Object;
@@ -218,6 +317,11 @@ namespace lv2c::ui
         virtual int ui_resize(int width, int height) override;
     private:
 
+        void VLog(Lv2cLogLevel level, const char *format, va_list args);
+        void WritePatchSet(LV2_URID property, const LV2_Atom *value, const std::string *stringValue);
+
+        Lv2PatchPropertyListeners patchPropertyListeners;
+
         void SelectFile(const std::string&patchProperty);
         void CloseFileDialog();
 
@@ -233,6 +337,7 @@ namespace lv2c::ui
         void *parentWindow = nullptr;
 
         LV2_Log_Log *log = nullptr;
+        std::unique_ptr<Lv2cLogSink> hostLogSink;
         LV2_URID_Map *map = nullptr;
         LV2_URID_Unmap *unmap = nullptr;
         LV2UI_Resize *resize = nullptr;
@@ -243,6 +348,7 @@ namespace lv2c::ui
 
         LV2_Atom_Forge_ *forge = nullptr;
         uint8_t patchRequestBuffer[128];
+        std::vector<uint8_t> patchSetBuffer;
 
         std::vector<EventHandle> fileElementClickedHandles;
     };
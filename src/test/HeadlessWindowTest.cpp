@@ -0,0 +1,148 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "CatchTest.hpp"
+
+#include "lv2c/Lv2cHeadlessWindow.hpp"
+#include "lv2c/Lv2cButtonElement.hpp"
+#include "lv2c/JsonIo.hpp"
+#include <chrono>
+#include <sstream>
+
+using namespace std;
+using namespace lv2c;
+
+static uint32_t GetPixel(Lv2cHeadlessWindow &headless, int x, int y)
+{
+    Lv2cImageSurface &surface = headless.Surface();
+    const uint8_t *row = surface.get_data() + y * surface.get_stride();
+    return ((const uint32_t *)row)[x] & 0x00FFFFFF;
+}
+
+TEST_CASE("Lv2cHeadlessWindow", "[headless_window]")
+{
+    using namespace std::chrono;
+
+    auto window = Lv2cWindow::Create();
+
+    auto element = Lv2cElement::Create();
+    element->Style()
+        .Background(Lv2cColor(1.0, 0.0, 0.0))
+        .HorizontalAlignment(Lv2cAlignment::Stretch)
+        .VerticalAlignment(Lv2cAlignment::Stretch);
+    window->GetRootElement()->AddChild(element);
+
+    Lv2cCreateWindowParameters parameters;
+    parameters.size = Lv2cSize(200, 100);
+    Lv2cHeadlessWindow &headless = window->CreateHeadlessWindow(parameters);
+    REQUIRE(window->HeadlessWindow() == &headless);
+    REQUIRE(headless.Size() == Lv2cSize(200, 100));
+
+    headless.RenderFrame();
+    REQUIRE(GetPixel(headless, 100, 50) == 0xFF0000);
+
+    element->Style().Background(Lv2cColor(0.0, 0.0, 1.0));
+    element->Invalidate();
+    headless.RenderFrame();
+    REQUIRE(GetPixel(headless, 100, 50) == 0x0000FF);
+
+    SECTION("Synthetic clock")
+    {
+        auto start = window->Now();
+        bool fired = false;
+        window->PostDelayed(100ms, [&fired]()
+                            { fired = true; });
+
+        headless.RenderFrame();
+        REQUIRE(!fired);
+        REQUIRE(window->Now() == start);
+
+        headless.Run(99ms);
+        REQUIRE(!fired);
+        headless.Run(1ms);
+        REQUIRE(fired);
+        REQUIRE(window->Now() - start == duration_cast<animation_clock_t::duration>(100ms));
+    }
+    SECTION("Synthetic input")
+    {
+        auto button = Lv2cButtonElement::Create();
+        button->Text("OK");
+        button->Style().Width(80).Height(40);
+        window->GetRootElement()->AddChild(button);
+        headless.RenderFrame();
+
+        int clicks = 0;
+        button->Clicked.AddListener([&clicks](const Lv2cMouseEventArgs &)
+                                    { ++clicks; return true; });
+
+        Lv2cPoint center{40, 20};
+        headless.Click(center);
+        // Clicks are delivered from a delayed callback.
+        REQUIRE(clicks == 0);
+        headless.RenderFrame();
+        REQUIRE(clicks == 1);
+
+        headless.Click(Lv2cPoint(150, 80));
+        headless.Run(100ms);
+        REQUIRE(clicks == 1);
+    }
+    SECTION("Resize")
+    {
+        window->Resize(50, 60);
+        REQUIRE(headless.Size() == Lv2cSize(50, 60));
+        REQUIRE(window->Size() == Lv2cSize(50, 60));
+        headless.RenderFrame();
+        REQUIRE(GetPixel(headless, 25, 30) == 0x0000FF);
+    }
+    SECTION("Frame instrumentation")
+    {
+        window->StartFrameTrace(10);
+
+        element->Invalidate();
+        headless.RenderFrame();
+        REQUIRE(window->FrameCounts().damageRects == 1);
+        REQUIRE(window->FrameCounts().elementsDrawn >= 1);
+        REQUIRE(window->FrameCounts().styleLookups > 0);
+
+        window->InvalidateLayout();
+        headless.RenderFrame();
+        REQUIRE(window->FrameCounts().elementsMeasured >= 2);
+
+        headless.RenderFrame();
+        REQUIRE(window->FrameCounts().damageRects == 0);
+        REQUIRE(window->FrameCounts().elementsDrawn == 0);
+
+        window->StopFrameTrace();
+        headless.RenderFrame();
+
+        std::stringstream s;
+        window->WriteFrameTrace(s);
+        std::string text = s.str();
+        json_reader reader(text);
+        json_variant trace;
+        trace.read(reader);
+
+        // frame, animate and counter events for each frame; measure/arrange and draw/present where they ran.
+        const json_variant &events = trace["traceEvents"];
+        REQUIRE(events.size() == 3 * 3 + 2 + 2 * 2);
+        REQUIRE(events[0]["name"].as_string() == "frame");
+        REQUIRE(events[0]["ph"].as_string() == "X");
+    }
+}
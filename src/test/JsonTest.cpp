@@ -23,7 +23,16 @@
 #include <locale>
 #include "lv2c/JsonVariant.hpp"
 #include "lv2c/JsonIo.hpp"
+#include "lv2c/JsonStream.hpp"
 #include <iostream>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <memory_resource>
+#include <malloc.h>
+#include <unistd.h>
+#include <sys/resource.h>
 
 using namespace lv2c;
 
@@ -182,3 +191,483 @@ TEST_CASE("JsonVariant, JsonIO test", "[json]")
 
     }
 }
+
+TEST_CASE("json_object key index", "[json]")
+{
+    json_variant v = json_variant::object();
+    json_object::ptr obj = v.as_object();
+
+    constexpr size_t N = 1000;
+    for (size_t i = 0; i < N; ++i)
+    {
+        REQUIRE(obj->is_indexed() == (i >= json_object::INDEX_THRESHOLD));
+        v["key" + std::to_string(i)] = (double)i;
+    }
+    REQUIRE(obj->is_indexed());
+    REQUIRE(obj->size() == N);
+
+    // lookups.
+    for (size_t i = 0; i < N; ++i)
+    {
+        std::string key = "key" + std::to_string(i);
+        REQUIRE(obj->contains(key));
+        REQUIRE(v[key].as<size_t>() == i);
+        REQUIRE(obj->find(key)->first == key);
+    }
+    REQUIRE(!obj->contains("key" + std::to_string(N)));
+    REQUIRE(obj->find("missing") == obj->end());
+    REQUIRE_THROWS(obj->at("missing"));
+
+    // assigning an existing key doesn't add a member.
+    v["key7"] = "seven";
+    REQUIRE(obj->size() == N);
+    REQUIRE(v["key7"].as_string() == "seven");
+
+    // insertion order is preserved.
+    size_t ix = 0;
+    for (const auto &member : *obj)
+    {
+        REQUIRE(member.first == "key" + std::to_string(ix));
+        ++ix;
+    }
+
+    // moved objects keep a valid index.
+    json_object moved{std::move(*obj)};
+    REQUIRE(moved.is_indexed());
+    REQUIRE(moved.at("key999").as<size_t>() == 999);
+
+    // round trip, and equality independent of member order.
+    json_variant t{std::move(moved)};
+    SerializationTest(t);
+
+    json_variant reversed = json_variant::object();
+    for (size_t i = N; i > 0; --i)
+    {
+        std::string key = "key" + std::to_string(i - 1);
+        reversed[key] = t[key];
+    }
+    REQUIRE(reversed == t);
+    reversed["key0"] = -1;
+    REQUIRE(reversed != t);
+}
+
+TEST_CASE("json_object lookup benchmark", "[json][benchmark][.]")
+{
+    for (size_t n : {8, 64, 1000, 10000})
+    {
+        std::vector<std::string> keys;
+        json_variant v = json_variant::object();
+        for (size_t i = 0; i < n; ++i)
+        {
+            keys.push_back("/home/user/recent/file" + std::to_string(i) + ".wav");
+            v[keys.back()] = (double)i;
+        }
+        const json_object &obj = *v.as_object();
+
+        constexpr size_t LOOKUPS = 1000000;
+        double sum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < LOOKUPS; ++i)
+        {
+            sum += obj.at(keys[(i * 7919) % n]).as_number();
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+        std::cout << "json_object::at  members: " << n
+                  << "  ns/lookup: " << ((double)elapsed.count() / LOOKUPS)
+                  << "  (" << sum << ")" << std::endl;
+    }
+}
+
+static json_variant ParseJson(std::string_view text)
+{
+    json_reader reader(text);
+    json_variant result;
+    result.read(reader);
+    REQUIRE(reader.is_complete());
+    return result;
+}
+
+TEST_CASE("json_reader buffer parsing", "[json]")
+{
+    {
+        // whitespace and comments, including long runs of indentation.
+        std::string indent(40, ' ');
+        std::string text =
+            "// leading comment\n" + indent + "{\n" + indent + "\"a\"\t:\r\n 1, /* block /* nested */ comment */\n" +
+            indent + "\"b\": [ true,false , null ]\n" + indent + "}" + indent + "\n";
+        json_variant v = ParseJson(text);
+        REQUIRE(v["a"].as<int>() == 1);
+        REQUIRE(v["b"].size() == 3);
+        REQUIRE(v["b"][0].as_bool() == true);
+        REQUIRE(v["b"][1].as_bool() == false);
+        REQUIRE(v["b"][2].is_null());
+    }
+    {
+        // strings with escapes at every offset relative to SIMD block boundaries.
+        for (size_t prefix = 0; prefix < 40; ++prefix)
+        {
+            std::string expected = std::string(prefix, 'x') + "\"\\\n\t\u00E9\u4E2D" + std::string(prefix, 'y');
+            json_variant v{expected};
+            std::string text = v.to_string();
+            REQUIRE(ParseJson(text).as_string() == expected);
+        }
+        {
+            json_reader reader("'single quoted'");
+            REQUIRE(reader.read_string() == "single quoted");
+        }
+        REQUIRE_THROWS_AS(ParseJson("\"unterminated"), json_exception);
+    }
+    {
+        // numbers.
+        REQUIRE(ParseJson("0").as_number() == 0);
+        REQUIRE(ParseJson("-12.5").as_number() == -12.5);
+        REQUIRE(ParseJson("1e3").as_number() == 1000);
+        REQUIRE(ParseJson("[1.25E-2,3]")[0].as_number() == 1.25E-2);
+        REQUIRE(std::isnan(ParseJson("NaN").as_number()));
+        REQUIRE_THROWS_AS(ParseJson("[1,x]"), json_exception);
+
+        for (bool allowNaN : {true, false})
+        {
+            for (const char *text : {"inf", "-inf", "infinity", "nan"})
+            {
+                json_reader reader(text);
+                reader.allowNaN(allowNaN);
+                double value;
+                REQUIRE_THROWS_AS(reader.read(&value), json_exception);
+            }
+        }
+    }
+    {
+        // istream reads consume only the characters of the value read.
+        std::stringstream s("1 2 [3,4] \"five\"");
+        json_variant a, b, c, d;
+        s >> a >> b >> c >> d;
+        REQUIRE(a.as<int>() == 1);
+        REQUIRE(b.as<int>() == 2);
+        REQUIRE(c.size() == 2);
+        REQUIRE(c[1].as<int>() == 4);
+        REQUIRE(d.as_string() == "five");
+    }
+    {
+        // memory-mapped files.
+        json_variant v = json_variant::object();
+        v["name"] = "settings";
+        v["values"] = std::vector<int>{1, 2, 3};
+
+        std::filesystem::path path = std::filesystem::temp_directory_path() / "lv2c_JsonTest.json";
+        {
+            std::ofstream f(path);
+            f << v;
+        }
+        json_variant t;
+        {
+            json_file_reader reader(path);
+            t.read(reader);
+        }
+        std::filesystem::remove(path);
+        REQUIRE(t == v);
+    }
+}
+
+static std::string MakeLargeJsonDocument(size_t entries)
+{
+    json_variant root = json_variant::object();
+    json_variant files = json_variant::array();
+    for (size_t i = 0; i < entries; ++i)
+    {
+        json_variant entry = json_variant::object();
+        entry["path"] = "/home/user/Music/Presets/Bank " + std::to_string(i / 100) + "/Preset " + std::to_string(i) + ".json";
+        entry["gain"] = -12.5 + i * 0.001;
+        entry["enabled"] = (i & 1) != 0;
+        entry["position"] = std::vector<double>{(double)i, i * 0.5};
+        files.as_array()->push_back(std::move(entry));
+    }
+    root["files"] = std::move(files);
+    return root.to_string();
+}
+
+TEST_CASE("json_reader benchmark", "[json][benchmark][.]")
+{
+    std::string text = MakeLargeJsonDocument(50000);
+
+    constexpr int ITERATIONS = 5;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i)
+    {
+        json_variant v;
+        json_reader reader(text);
+        v.read(reader);
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / ITERATIONS;
+
+    std::cout << "json_reader  bytes: " << text.size()
+              << "  ms/parse: " << elapsed * 1000
+              << "  MB/s: " << (text.size() / elapsed / 1.0E6) << std::endl;
+}
+
+class StreamedPreset
+{
+public:
+    void Write(json_stream_writer &writer) const
+    {
+        writer.start_object();
+        writer.member("name", name);
+        writer.member("gain", gain);
+        writer.member("values", values);
+        writer.end_object();
+    }
+
+    std::string name;
+    double gain = 0;
+    std::vector<int> values;
+};
+
+TEST_CASE("json_stream_writer", "[json]")
+{
+    std::vector<StreamedPreset> presets{
+        {"Clean", -3.5, {1, 2, 3}},
+        {"Crunch", 6, {}},
+    };
+
+    std::stringstream s;
+    {
+        json_stream_writer writer(s);
+        writer.start_object();
+        writer.member("version", 2);
+        writer.member("enabled", true);
+        writer.key("nothing");
+        writer.null_value();
+        writer.member("presets", presets);
+        writer.member("extra", json_variant(std::vector<std::string>{"a", "b"}));
+        writer.end_object();
+    }
+
+    json_variant expected = json_variant::object();
+    expected["version"] = 2;
+    expected["enabled"] = true;
+    expected["nothing"] = json_null();
+    json_variant expectedPresets = json_variant::array();
+    for (const auto &preset : presets)
+    {
+        json_variant p = json_variant::object();
+        p["name"] = preset.name;
+        p["gain"] = preset.gain;
+        p["values"] = preset.values;
+        expectedPresets.as_array()->push_back(std::move(p));
+    }
+    expected["presets"] = std::move(expectedPresets);
+    expected["extra"] = std::vector<std::string>{"a", "b"};
+
+    json_variant actual;
+    s >> actual;
+    REQUIRE(actual == expected);
+
+    {
+        std::stringstream s;
+        json_stream_writer writer(s);
+        writer.start_object();
+        REQUIRE_THROWS_AS(writer.value(1.0), json_exception);
+        REQUIRE_THROWS_AS(writer.end_array(), json_exception);
+    }
+}
+
+TEST_CASE("json_event_reader", "[json]")
+{
+    std::string text = R"({
+        "version": 2,
+        "history": [ "a", {"b": [1,2,{}]}, [], null ],
+        "settings": { "gain": -3.5, "enabled": true },
+        "name": "test"
+    })";
+    {
+        // token sequence.
+        json_reader reader(text);
+        json_event_reader events(reader);
+        std::vector<json_token> tokens;
+        while (events.next() != json_token::EndOfInput)
+        {
+            tokens.push_back(events.token());
+        }
+        using T = json_token;
+        std::vector<json_token> expected{
+            T::StartObject,
+            T::Key, T::Number,
+            T::Key, T::StartArray, T::String, T::StartObject, T::Key, T::StartArray, T::Number, T::Number, T::StartObject, T::EndObject, T::EndArray, T::EndObject, T::StartArray, T::EndArray, T::Null, T::EndArray,
+            T::Key, T::StartObject, T::Key, T::Number, T::Key, T::Bool, T::EndObject,
+            T::Key, T::String,
+            T::EndObject};
+        REQUIRE(tokens == expected);
+    }
+    {
+        // pick out selected fields, skipping the rest.
+        json_reader reader(text);
+        json_event_reader events(reader);
+        REQUIRE(events.next() == json_token::StartObject);
+        double version = 0;
+        std::string name;
+        json_variant settings;
+        while (events.next() == json_token::Key)
+        {
+            std::string key = events.string_value();
+            if (key == "version")
+            {
+                REQUIRE(events.next() == json_token::Number);
+                version = events.number_value();
+            }
+            else if (key == "name")
+            {
+                REQUIRE(events.next() == json_token::String);
+                name = events.string_value();
+            }
+            else if (key == "settings")
+            {
+                settings = events.read_variant();
+            }
+            else
+            {
+                events.skip_value();
+            }
+        }
+        REQUIRE(events.token() == json_token::EndObject);
+        REQUIRE(events.next() == json_token::EndOfInput);
+        REQUIRE(version == 2);
+        REQUIRE(name == "test");
+        REQUIRE(settings["gain"].as_number() == -3.5);
+        REQUIRE(settings["enabled"].as_bool() == true);
+    }
+    {
+        // read_variant produces the same tree as json_variant::read.
+        json_reader reader(text);
+        json_event_reader events(reader);
+        json_variant v = events.read_variant();
+
+        json_reader reader2(text);
+        json_variant expected;
+        expected.read(reader2);
+        REQUIRE(v == expected);
+    }
+    {
+        json_reader reader("[1,}");
+        json_event_reader events(reader);
+        REQUIRE_THROWS_AS(events.read_variant(), json_exception);
+    }
+}
+
+// A memory resource that counts allocations made through it.
+class CountingMemoryResource : public std::pmr::memory_resource
+{
+public:
+    CountingMemoryResource(std::pmr::memory_resource *upstream) : upstream(upstream) {}
+    size_t allocations = 0;
+
+private:
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        ++allocations;
+        return upstream->allocate(bytes, alignment);
+    }
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override
+    {
+        upstream->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+    std::pmr::memory_resource *upstream;
+};
+
+TEST_CASE("json_variant arena allocation", "[json]")
+{
+    std::string text = MakeLargeJsonDocument(100);
+
+    json_variant heapTree = ParseJson(text);
+
+    CountingMemoryResource counter{std::pmr::new_delete_resource()};
+    {
+        std::pmr::monotonic_buffer_resource arena{&counter};
+        json_variant arenaTree;
+        {
+            json_reader reader(text);
+            reader.memory_resource(&arena);
+            arenaTree.read(reader);
+        }
+        REQUIRE(arenaTree == heapTree);
+
+        // objects created from the arena can be modified.
+        arenaTree["files"][0]["name"] = "modified";
+        for (int i = 0; i < 100; ++i)
+        {
+            arenaTree["files"][0]["key" + std::to_string(i)] = i;
+        }
+        REQUIRE(arenaTree["files"][0]["key99"].as<int>() == 99);
+        REQUIRE(arenaTree != heapTree);
+
+        {
+            json_reader reader(text);
+            reader.memory_resource(&arena);
+            json_event_reader events(reader);
+            REQUIRE(events.read_variant() == heapTree);
+        }
+    }
+    // arena memory comes from the upstream resource in a few large blocks.
+    REQUIRE(counter.allocations > 0);
+    REQUIRE(counter.allocations < 32);
+}
+
+// Current resident set size of the process, in bytes.
+static size_t ResidentBytes()
+{
+    size_t pages = 0, residentPages = 0;
+    std::ifstream f("/proc/self/statm");
+    f >> pages >> residentPages;
+    return residentPages * (size_t)sysconf(_SC_PAGESIZE);
+}
+
+// High-water mark of the resident set size of the process, in bytes.
+static size_t PeakResidentBytes()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+    return (size_t)usage.ru_maxrss * 1024;
+}
+
+TEST_CASE("json_variant arena benchmark", "[json][benchmark][.]")
+{
+    std::string text = MakeLargeJsonDocument(50000);
+
+    for (int useArena = 0; useArena < 2; ++useArena)
+    {
+        malloc_trim(0);
+        size_t rssBefore = ResidentBytes();
+
+        auto start = std::chrono::steady_clock::now();
+        double treeBytes;
+        {
+            std::pmr::monotonic_buffer_resource arena;
+            json_variant v;
+            {
+                json_reader reader(text);
+                if (useArena)
+                {
+                    reader.memory_resource(&arena);
+                }
+                v.read(reader);
+            }
+            treeBytes = (double)(ResidentBytes() - rssBefore);
+        }
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // The live figure is RSS growth while the finished tree is held. The
+        // peak figure is process-wide and never decreases, so the second row
+        // only shows growth beyond the first.
+        std::cout << (useArena ? "arena" : "heap ")
+                  << "  ms/parse+free: " << elapsed * 1000
+                  << "  live tree RSS MB: " << treeBytes / 1.0E6
+                  << "  peak RSS MB: " << PeakResidentBytes() / 1.0E6 << std::endl;
+    }
+}
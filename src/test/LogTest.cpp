@@ -0,0 +1,169 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "CatchTest.hpp"
+
+#include "lv2c/Lv2cLog.hpp"
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <string>
+
+using namespace std;
+using namespace lv2c;
+
+namespace
+{
+    class TestLogSink : public Lv2cLogSink
+    {
+    public:
+        virtual void Write(Lv2cLogLevel level, const char *message) override
+        {
+            std::lock_guard lock{mutex};
+            messages.push_back(message);
+            levels.push_back(level);
+        }
+        std::vector<std::string> Messages()
+        {
+            std::lock_guard lock{mutex};
+            return messages;
+        }
+
+        std::vector<Lv2cLogLevel> levels;
+
+    private:
+        std::mutex mutex;
+        std::vector<std::string> messages;
+    };
+}
+
+TEST_CASE("Lv2cLog", "[log]")
+{
+    Lv2cLogLevel savedLevel = GetLogLevel();
+    SetLogLevel(Lv2cLogLevel::Info);
+
+    TestLogSink sink;
+    AddLogSink(&sink);
+
+    SECTION("Messages arrive in order")
+    {
+        for (int i = 0; i < 10; ++i)
+        {
+            LogInfo("message " + std::to_string(i));
+        }
+        FlushLog();
+        auto messages = sink.Messages();
+        REQUIRE(messages.size() == 10);
+        for (int i = 0; i < 10; ++i)
+        {
+            REQUIRE(messages[i] == "message " + std::to_string(i));
+        }
+    }
+    SECTION("Level filtering")
+    {
+        SetLogLevel(Lv2cLogLevel::Warning);
+        LogInfo("info");
+        LogWarning("warning");
+        LogError("error");
+        LogDebug("debug");
+        LV2C_LOG_TRACE("trace");
+        FlushLog();
+        auto messages = sink.Messages();
+        REQUIRE(messages.size() == 2);
+        REQUIRE(messages[0] == "warning");
+        REQUIRE(sink.levels[0] == Lv2cLogLevel::Warning);
+        REQUIRE(messages[1] == "error");
+        REQUIRE(sink.levels[1] == Lv2cLogLevel::Error);
+    }
+    SECTION("Repeated messages are rate-limited")
+    {
+        for (int i = 0; i < 20; ++i)
+        {
+            LogError("repeated");
+        }
+        LogError("different");
+        FlushLog();
+        auto messages = sink.Messages();
+        size_t repeats = 0;
+        for (const auto &message : messages)
+        {
+            if (message == "repeated")
+            {
+                ++repeats;
+            }
+        }
+        REQUIRE(repeats < 20);
+        REQUIRE(messages.size() == repeats + 2);
+        REQUIRE(messages[repeats] == "(Last message repeated " + std::to_string(20 - repeats) + " more times.)");
+        REQUIRE(messages[repeats + 1] == "different");
+    }
+    SECTION("Long messages are truncated")
+    {
+        LogInfo(std::string(10000, 'x'));
+        FlushLog();
+        auto messages = sink.Messages();
+        REQUIRE(messages.size() == 1);
+        REQUIRE(messages[0].length() > 0);
+        REQUIRE(messages[0].length() < 10000);
+    }
+    SECTION("Multiple threads")
+    {
+        constexpr int N_THREADS = 4;
+        constexpr int N_MESSAGES = 50;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < N_THREADS; ++t)
+        {
+            threads.emplace_back(
+                [t]()
+                {
+                    for (int i = 0; i < N_MESSAGES; ++i)
+                    {
+                        LogInfo(std::to_string(t) + ":" + std::to_string(i));
+                    }
+                });
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+        FlushLog();
+
+        // messages may be dropped if the queue overflows, but those that arrive are intact and in per-thread order.
+        auto messages = sink.Messages();
+        REQUIRE(messages.size() > 0);
+        int lastMessage[N_THREADS] = {-1, -1, -1, -1};
+        for (const auto &message : messages)
+        {
+            auto pos = message.find(':');
+            if (pos == std::string::npos)
+            {
+                REQUIRE(message.starts_with("Log queue overflow."));
+                continue;
+            }
+            int t = std::stoi(message.substr(0, pos));
+            int i = std::stoi(message.substr(pos + 1));
+            REQUIRE(i > lastMessage[t]);
+            lastMessage[t] = i;
+        }
+    }
+
+    RemoveLogSink(&sink);
+    SetLogLevel(savedLevel);
+}
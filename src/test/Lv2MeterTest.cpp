@@ -0,0 +1,168 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "CatchTest.hpp"
+
+#include "Lv2Meter.hpp"
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace lv2;
+
+static bool ApproxEqual(double v1, double v2, double tolerance)
+{
+    return std::abs(v1 - v2) < tolerance;
+}
+
+TEST_CASE("Lv2Meter FastDb", "[lv2meter]")
+{
+    // exact at powers of two.
+    REQUIRE(Lv2Meter::FastDb(1.0f) == 0.0f);
+    REQUIRE(ApproxEqual(Lv2Meter::FastDb(0.5f), -6.0206, 1E-4));
+    REQUIRE(ApproxEqual(Lv2Meter::FastDb(4.0f), 12.0412, 1E-4));
+
+    float maxError = 0;
+    for (float amplitude = 2.0E-5f; amplitude < 8.0f; amplitude *= 1.0007f)
+    {
+        float error = std::abs(Lv2Meter::FastDb(amplitude) - 20 * std::log10(amplitude));
+        maxError = std::max(maxError, error);
+    }
+    REQUIRE(maxError < 0.05f);
+
+    REQUIRE(Lv2Meter::FastDb(0.0f) == Lv2Meter::MIN_DB);
+    REQUIRE(Lv2Meter::FastDb(-1.0f) == Lv2Meter::MIN_DB);
+    REQUIRE(Lv2Meter::FastDb(1.0E-9f) == Lv2Meter::MIN_DB);
+    REQUIRE(Lv2Meter::FastDb(std::numeric_limits<float>::quiet_NaN()) == Lv2Meter::MIN_DB);
+}
+
+TEST_CASE("Lv2Meter Peak and SumOfSquares", "[lv2meter]")
+{
+    std::vector<float> buffer(64);
+    for (size_t i = 0; i < buffer.size(); ++i)
+    {
+        buffer[i] = std::sin(i * 0.37f) * 0.25f;
+    }
+    // lengths that are not multiples of the vector width, at unaligned offsets.
+    for (size_t offset = 0; offset < 4; ++offset)
+    {
+        for (size_t n = 0; n <= 37; ++n)
+        {
+            std::vector<float> data(buffer.begin() + offset, buffer.begin() + offset + n);
+            if (n != 0)
+            {
+                data[n - 1] = -0.9f; // the peak is in the scalar tail.
+            }
+            float expectedPeak = 0;
+            double expectedSum = 0;
+            for (float v : data)
+            {
+                expectedPeak = std::max(expectedPeak, std::abs(v));
+                expectedSum += v * v;
+            }
+            REQUIRE(Lv2Meter::Peak(data.data(), n) == expectedPeak);
+            REQUIRE(ApproxEqual(Lv2Meter::SumOfSquares(data.data(), n), expectedSum, 1E-6));
+        }
+    }
+}
+
+TEST_CASE("Lv2Meter decimation and peak hold", "[lv2meter]")
+{
+    // 10-sample windows, ports updated at most every 40 samples.
+    constexpr double SAMPLE_RATE = 1000;
+    constexpr uint32_t BLOCK = 5;
+    std::vector<float> silence(BLOCK, 0.001f);
+    std::vector<float> spike(BLOCK, 0.001f);
+    spike[2] = -0.5f;
+
+    {
+        Lv2Meter meter;
+        meter.Prepare(SAMPLE_RATE, Lv2Meter::Mode::Peak, 0.010, 25);
+        float port = 1234;
+        REQUIRE(!meter.Update(nullptr));
+
+        std::vector<uint32_t> updateTimes;
+        for (uint32_t t = BLOCK; t <= 400; t += BLOCK)
+        {
+            meter.Process(silence.data(), BLOCK);
+            if (meter.Update(&port))
+            {
+                updateTimes.push_back(t);
+            }
+        }
+        // the first update waits for a complete window; later ones for the update interval.
+        REQUIRE(updateTimes == std::vector<uint32_t>{10, 50, 90, 130, 170, 210, 250, 290, 330, 370});
+        REQUIRE(port == Lv2Meter::FastDb(0.001f));
+    }
+    {
+        // a peak in a window between updates is held until the next update.
+        Lv2Meter meter;
+        meter.Prepare(SAMPLE_RATE, Lv2Meter::Mode::Peak, 0.010, 25);
+        float port = 0;
+        meter.Process(silence.data(), BLOCK);
+        meter.Process(silence.data(), BLOCK);
+        REQUIRE(meter.Update(&port)); // t = 10
+
+        meter.Process(spike.data(), BLOCK);
+        REQUIRE(!meter.Update(&port));
+        for (uint32_t t = 20; t < 50; t += BLOCK)
+        {
+            meter.Process(silence.data(), BLOCK);
+            REQUIRE(!meter.Update(&port));
+        }
+        meter.Process(silence.data(), BLOCK);
+        REQUIRE(meter.Update(&port)); // t = 50
+        REQUIRE(port == Lv2Meter::FastDb(0.5f));
+
+        for (uint32_t t = 50; t < 90; t += BLOCK)
+        {
+            meter.Process(silence.data(), BLOCK);
+        }
+        REQUIRE(meter.Update(&port)); // t = 90
+        REQUIRE(port == Lv2Meter::FastDb(0.001f));
+
+        // gain is applied to the metered level.
+        for (uint32_t t = 90; t < 130; t += BLOCK)
+        {
+            meter.Process(spike.data(), BLOCK, -2.0f);
+        }
+        REQUIRE(meter.Update(&port));
+        REQUIRE(port == Lv2Meter::FastDb(1.0f));
+
+        // Reset discards pending levels.
+        meter.Process(spike.data(), BLOCK);
+        meter.Reset();
+        REQUIRE(!meter.Update(&port));
+    }
+    {
+        // RMS of a full-scale sine is -3dB.
+        Lv2Meter meter;
+        meter.Prepare(48000, Lv2Meter::Mode::Rms);
+        std::vector<float> sine(4800);
+        for (size_t i = 0; i < sine.size(); ++i)
+        {
+            sine[i] = std::sin(i * 2 * 3.14159265 * 1000 / 48000);
+        }
+        float port = 0;
+        meter.Process(sine.data(), (uint32_t)sine.size());
+        REQUIRE(meter.Update(&port));
+        REQUIRE(ApproxEqual(port, -3.0103, 0.06));
+    }
+}
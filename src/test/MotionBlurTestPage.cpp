@@ -24,6 +24,10 @@
 #include "lv2c/Lv2cTypographyElement.hpp"
 #include "lv2c/Lv2cSlideInOutAnimationElement.hpp"
 #include "lv2c/Lv2cDropdownElement.hpp"
+#include "lv2c/Lv2cDrawingContext.hpp"
+#include <chrono>
+#include <sstream>
+#include <iomanip>
 
 using namespace lv2c;
 
@@ -113,6 +117,25 @@ Lv2cElement::ptr MotionBlurTestPage::CreatePageView(Lv2cTheme::ptr theme)
         );
         main->AddChild(dropdown);
     }
+    {
+        auto button = Lv2cButtonElement::Create();
+        button->Variant(Lv2cButtonVariant::BorderButton);
+        button->Text("Benchmark");
+        benchmarkClickedHandle = button->Clicked.AddListener(
+            [this](const Lv2cMouseEventArgs &)
+            {
+                RunBenchmark();
+                return true;
+            });
+        main->AddChild(button);
+
+        benchmarkResult = Lv2cTypographyElement::Create();
+        benchmarkResult->Variant(Lv2cTypographyVariant::BodySecondary);
+        benchmarkResult->Style()
+            .Width(300)
+            .SingleLine(false);
+        main->AddChild(benchmarkResult);
+    }
 
     {
         // divider.
@@ -271,3 +294,51 @@ Lv2cElement::ptr MotionBlurTestPage::CreatePageView(Lv2cTheme::ptr theme)
     }
     return (main);
 }
+
+void MotionBlurTestPage::RunBenchmark()
+{
+    // Time the blur filter on a full 300x300 element (the slide-in demo above),
+    // and on a 300x48 strip, which is roughly what a partial redraw filters.
+    struct BenchmarkCase
+    {
+        const char *name;
+        int width, height;
+        Lv2cPoint from, to;
+    };
+    BenchmarkCase cases[] = {
+        {"Vertical, 300x300", 300, 300, Lv2cPoint(0, -23), Lv2cPoint(0, -18)},
+        {"Horizontal, 300x300", 300, 300, Lv2cPoint(-23, 0), Lv2cPoint(-18, 0)},
+        {"Vertical (long), 300x300", 300, 300, Lv2cPoint(0, -60), Lv2cPoint(0, 0)},
+        {"Vertical, 300x48", 300, 48, Lv2cPoint(0, -23), Lv2cPoint(0, -18)},
+    };
+    constexpr int ITERATIONS = 200;
+
+    std::stringstream s;
+    s << std::fixed << std::setprecision(3);
+    for (const auto &benchmarkCase : cases)
+    {
+        Lv2cImageSurface source{cairo_format_t::CAIRO_FORMAT_ARGB32, benchmarkCase.width, benchmarkCase.height};
+        Lv2cImageSurface result{cairo_format_t::CAIRO_FORMAT_ARGB32, benchmarkCase.width, benchmarkCase.height};
+        {
+            Lv2cDrawingContext dc{source};
+            for (int i = 0; i < 10; ++i)
+            {
+                dc.set_source(Lv2cColor(i / 10.0, 0.5, 1 - i / 10.0, 0.8));
+                dc.rectangle(Lv2cRectangle(i * 27, i * 13 % benchmarkCase.height, 40, 40));
+                dc.fill();
+            }
+        }
+
+        Lv2cMotionBlurElement::MotionBlurFilter(source, result, benchmarkCase.from, benchmarkCase.to);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ITERATIONS; ++i)
+        {
+            Lv2cMotionBlurElement::MotionBlurFilter(source, result, benchmarkCase.from, benchmarkCase.to);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        double ms = std::chrono::duration<double, std::milli>(elapsed).count() / ITERATIONS;
+
+        s << benchmarkCase.name << ": " << ms << "ms\n";
+    }
+    benchmarkResult->Text(s.str());
+}
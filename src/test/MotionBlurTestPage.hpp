@@ -21,6 +21,7 @@
 
 #include "TestPage.hpp"
 #include "lv2c/Lv2cBindingProperty.hpp"
+#include "lv2c/Lv2cTypographyElement.hpp"
 
 namespace lv2c {
 class MotionBlurTestPage : public TestPage
@@ -36,7 +37,11 @@ public:
     }
     Lv2cElement::ptr CreatePageView(Lv2cTheme::ptr theme) override;
 private:
+    void RunBenchmark();
+
     observer_handle_t selectSlideAnimationObserverHandle;
+    EventHandle benchmarkClickedHandle;
+    Lv2cTypographyElement::ptr benchmarkResult;
 
 
 };
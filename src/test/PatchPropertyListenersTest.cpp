@@ -0,0 +1,111 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "CatchTest.hpp"
+
+#include "lv2c_ui/Lv2PatchPropertyListeners.hpp"
+#include <memory>
+#include <vector>
+
+using namespace lv2c;
+using namespace lv2c::ui;
+
+TEST_CASE("Lv2PatchPropertyListeners dispatch", "[lv2ui]")
+{
+    constexpr LV2_URID PROPERTY_A = 1;
+    constexpr LV2_URID PROPERTY_B = 2;
+    LV2_Atom atom{0, 0};
+
+    {
+        // dispatch by property.
+        Lv2PatchPropertyListeners listeners;
+        int aCalls = 0, bCalls = 0;
+        EventHandle a = listeners.Add(PROPERTY_A, [&](const LV2_Atom *value) { REQUIRE(value == &atom); ++aCalls; });
+        listeners.Add(PROPERTY_B, [&](const LV2_Atom *) { ++bCalls; });
+
+        listeners.Dispatch(PROPERTY_A, &atom);
+        REQUIRE(aCalls == 1);
+        REQUIRE(bCalls == 0);
+
+        REQUIRE(listeners.Remove(a));
+        REQUIRE(!listeners.Remove(a));
+        listeners.Dispatch(PROPERTY_A, &atom);
+        REQUIRE(aCalls == 1);
+        REQUIRE(listeners.size() == 1);
+    }
+    {
+        // a listener that removes itself. The listener's captures must survive until it returns.
+        Lv2PatchPropertyListeners listeners;
+        EventHandle self;
+        int calls = 0;
+        auto captured = std::make_shared<std::vector<int>>(1000, 7);
+        self = listeners.Add(
+            PROPERTY_A,
+            [&listeners, &self, &calls, captured](const LV2_Atom *)
+            {
+                REQUIRE(listeners.Remove(self));
+                // touches the closure after removal.
+                REQUIRE(captured->size() == 1000);
+                REQUIRE((*captured)[999] == 7);
+                ++calls;
+            });
+        std::weak_ptr<std::vector<int>> weakCaptured = captured;
+        captured = nullptr;
+
+        listeners.Dispatch(PROPERTY_A, &atom);
+        REQUIRE(calls == 1);
+        REQUIRE(listeners.size() == 0);
+        // destroyed once dispatch completes.
+        REQUIRE(weakCaptured.expired());
+
+        listeners.Dispatch(PROPERTY_A, &atom);
+        REQUIRE(calls == 1);
+    }
+    {
+        // removing a later listener during dispatch, and adding listeners during dispatch.
+        Lv2PatchPropertyListeners listeners;
+        EventHandle second;
+        int firstCalls = 0, secondCalls = 0, addedCalls = 0;
+        listeners.Add(
+            PROPERTY_A,
+            [&](const LV2_Atom *)
+            {
+                ++firstCalls;
+                if (firstCalls == 1)
+                {
+                    listeners.Remove(second);
+                    listeners.Add(PROPERTY_A, [&](const LV2_Atom *) { ++addedCalls; });
+                    listeners.Add(PROPERTY_B, [&](const LV2_Atom *) { ++addedCalls; });
+                }
+            });
+        second = listeners.Add(PROPERTY_A, [&](const LV2_Atom *) { ++secondCalls; });
+
+        listeners.Dispatch(PROPERTY_A, &atom);
+        REQUIRE(firstCalls == 1);
+        REQUIRE(secondCalls == 0);
+        REQUIRE(addedCalls == 0);
+
+        listeners.Dispatch(PROPERTY_A, &atom);
+        REQUIRE(firstCalls == 2);
+        REQUIRE(secondCalls == 0);
+        REQUIRE(addedCalls == 1);
+        REQUIRE(listeners.size() == 3);
+    }
+}
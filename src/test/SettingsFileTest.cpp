@@ -0,0 +1,105 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "CatchTest.hpp"
+#include "lv2c/Lv2cSettingsFile.hpp"
+#include <filesystem>
+#include <cstdlib>
+
+using namespace lv2c;
+
+TEST_CASE("Lv2cSettingsFile write-behind", "[settings]")
+{
+    // Redirect settings files to a temporary directory.
+    std::filesystem::path home = std::filesystem::temp_directory_path() / "lv2c_SettingsFileTest";
+    std::string oldHome = std::getenv("HOME") ? std::getenv("HOME") : "";
+    setenv("HOME", home.c_str(), 1);
+
+    {
+        Lv2cSettingsFile settings;
+        settings.Load("write_behind_test");
+        settings.WriteBehindDelay(std::chrono::milliseconds(10000));
+
+        for (int i = 0; i < 10; ++i)
+        {
+            settings.Root()["value"] = i;
+            settings.Update();
+        }
+        // nothing changed: not counted.
+        settings.Update();
+        REQUIRE(settings.WritesAvoided() == 9);
+    }
+    {
+        // the destructor flushed the last value; Flush() writes a pending value immediately.
+        Lv2cSettingsFile settings;
+        settings.Load("write_behind_test");
+        REQUIRE(settings.Root()["value"].as<int>() == 9);
+
+        settings.Root()["value"] = 10;
+        settings.Update();
+        settings.Flush();
+
+        Lv2cSettingsFile other;
+        other.Load("write_behind_test");
+        REQUIRE(other.Root()["value"].as<int>() == 10);
+    }
+    {
+        // synchronous writes.
+        Lv2cSettingsFile settings;
+        settings.Load("write_behind_test");
+        settings.WriteBehindDelay(std::chrono::milliseconds(0));
+        settings.Root()["value"] = 11;
+        settings.Update();
+
+        Lv2cSettingsFile other;
+        other.Load("write_behind_test");
+        REQUIRE(other.Root()["value"].as<int>() == 11);
+        REQUIRE(settings.WritesAvoided() == 0);
+    }
+    {
+        // a failed write is retried by the next update, even if the value is unchanged.
+        Lv2cSettingsFile settings;
+        settings.Load("write_behind_test");
+        settings.WriteBehindDelay(std::chrono::milliseconds(0));
+
+        // a directory in place of the temporary file makes the write fail.
+        std::filesystem::path settingsPath = home / ".config" / "io.github.rerdavies.lv2cairo" / "write_behind_test" / "settings.json";
+        std::filesystem::path blocker = settingsPath.string() + ".$$$";
+        std::filesystem::create_directories(blocker);
+
+        settings.Root()["value"] = 12;
+        settings.Update();
+        {
+            Lv2cSettingsFile other;
+            other.Load("write_behind_test");
+            REQUIRE(other.Root()["value"].as<int>() == 11);
+        }
+
+        std::filesystem::remove(blocker);
+        settings.Update();
+        {
+            Lv2cSettingsFile other;
+            other.Load("write_behind_test");
+            REQUIRE(other.Root()["value"].as<int>() == 12);
+        }
+    }
+
+    std::filesystem::remove_all(home);
+    setenv("HOME", oldHome.c_str(), 1);
+}
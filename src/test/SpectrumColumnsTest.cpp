@@ -0,0 +1,113 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "CatchTest.hpp"
+
+#include "lv2c_ui/Lv2SpectrumElement.hpp"
+#include <vector>
+#include <cmath>
+
+using namespace std;
+using namespace lv2c::ui;
+
+TEST_CASE("Lv2SpectrumColumns waveform", "[spectrum_columns]")
+{
+    Lv2SpectrumColumns columns;
+
+    // More samples than columns: min/max of each group of 4 samples.
+    columns.WaveformLayout(4, 16);
+    REQUIRE(columns.InputSize() == 16);
+    REQUIRE(columns.Columns() == 4);
+
+    vector<float> samples(16);
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+        samples[i] = (i % 2 == 0) ? (float)i : -(float)i;
+    }
+    columns.Reduce(samples.data());
+    for (size_t x = 0; x < 4; ++x)
+    {
+        REQUIRE(columns.Min()[x] == -(float)(x * 4 + 3));
+        REQUIRE(columns.Max()[x] == (float)(x * 4 + 2));
+    }
+
+    // Fewer samples than columns: every column gets at least one sample.
+    columns.WaveformLayout(8, 3);
+    vector<float> few{1, 2, 3};
+    columns.Reduce(few.data());
+    for (size_t x = 0; x < 8; ++x)
+    {
+        REQUIRE(columns.Min()[x] == columns.Max()[x]);
+        REQUIRE(columns.Max()[x] >= 1);
+        REQUIRE(columns.Max()[x] <= 3);
+    }
+    REQUIRE(columns.Max()[0] == 1);
+    REQUIRE(columns.Max()[7] == 3);
+}
+
+TEST_CASE("Lv2SpectrumColumns spectrum", "[spectrum_columns]")
+{
+    Lv2SpectrumColumns columns;
+
+    // 1025 bins over 0..24000Hz: 23.4375Hz per bin.
+    constexpr size_t BINS = 1025;
+    constexpr double SAMPLE_RATE = 48000;
+    constexpr double BIN_WIDTH = SAMPLE_RATE / 2 / (BINS - 1);
+    columns.SpectrumLayout(200, BINS, SAMPLE_RATE, 20, 20000);
+    REQUIRE(columns.InputSize() == BINS);
+
+    // A single peak at 1kHz shows up in the column that contains 1kHz, and nowhere else.
+    vector<float> bins(BINS, 0.0f);
+    size_t peakBin = (size_t)std::round(1000 / BIN_WIDTH);
+    bins[peakBin] = 1.0f;
+    columns.Reduce(bins.data());
+
+    double peakFrequency = peakBin * BIN_WIDTH;
+    size_t expectedColumn = (size_t)(200 * std::log(peakFrequency / 20) / std::log(20000.0 / 20));
+    size_t peakColumns = 0;
+    for (size_t x = 0; x < columns.Columns(); ++x)
+    {
+        if (columns.Max()[x] == 1.0f)
+        {
+            ++peakColumns;
+            REQUIRE(x == expectedColumn);
+        }
+        else
+        {
+            // neighbouring columns may interpolate toward the peak, but never reach it.
+            REQUIRE(columns.Max()[x] < 1.0f);
+        }
+    }
+    REQUIRE(peakColumns == 1);
+
+    // Columns narrower than a bin interpolate between bins.
+    std::fill(bins.begin(), bins.end(), 0.0f);
+    for (size_t i = 0; i < BINS; ++i)
+    {
+        bins[i] = (float)i;
+    }
+    columns.Reduce(bins.data());
+    // 20Hz is below the first bin: interpolated, and non-decreasing from left to right.
+    REQUIRE(columns.Max()[0] > 0);
+    REQUIRE(columns.Max()[0] < 1);
+    for (size_t x = 1; x < columns.Columns(); ++x)
+    {
+        REQUIRE(columns.Max()[x] >= columns.Max()[x - 1]);
+    }
+}
@@ -0,0 +1,99 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "CatchTest.hpp"
+
+#include "lv2c/Lv2cSurfacePool.hpp"
+#include <chrono>
+#include <thread>
+
+using namespace std;
+using namespace lv2c;
+
+TEST_CASE("Lv2cSurfacePool", "[surface_pool]")
+{
+    auto pool = Lv2cSurfacePool::Create();
+
+    unsigned char *firstData;
+    {
+        Lv2cImageSurface surface = pool->Acquire(cairo_format_t::CAIRO_FORMAT_ARGB32, 300, 200);
+        REQUIRE(surface.status() == cairo_status_t::CAIRO_STATUS_SUCCESS);
+        REQUIRE(surface.get_width() == 300);
+        REQUIRE(surface.get_height() == 200);
+        REQUIRE(pool->Allocations() == 1);
+        REQUIRE(pool->BytesInUse() >= 300 * 200 * 4);
+        REQUIRE(pool->FreeBytes() == 0);
+
+        firstData = surface.get_data();
+        for (int i = 0; i < 300 * 4; ++i)
+        {
+            REQUIRE(firstData[i] == 0);
+        }
+        firstData[0] = 0xFF;
+    }
+    REQUIRE(pool->BytesInUse() == 0);
+    REQUIRE(pool->FreeBytes() >= 300 * 200 * 4);
+
+    {
+        // A similar size reuses the same buffer, and it is cleared again.
+        Lv2cImageSurface surface = pool->Acquire(cairo_format_t::CAIRO_FORMAT_ARGB32, 299, 200);
+        REQUIRE(surface.get_width() == 299);
+        REQUIRE(surface.get_data() == firstData);
+        REQUIRE(surface.get_data()[0] == 0);
+        REQUIRE(pool->Allocations() == 1);
+
+        // Copies keep the buffer alive.
+        Lv2cImageSurface copy = surface;
+        surface.release();
+        REQUIRE(pool->FreeBytes() == 0);
+    }
+    REQUIRE(pool->FreeBytes() != 0);
+    {
+        // A very different size gets a new buffer.
+        Lv2cImageSurface surface = pool->Acquire(cairo_format_t::CAIRO_FORMAT_A8, 16, 16);
+        REQUIRE(surface.get_format() == cairo_format_t::CAIRO_FORMAT_A8);
+        REQUIRE(pool->Allocations() == 2);
+    }
+
+    SECTION("High-water mark")
+    {
+        pool->HighWaterMark(0);
+        REQUIRE(pool->FreeBytes() == 0);
+        {
+            Lv2cImageSurface surface = pool->Acquire(cairo_format_t::CAIRO_FORMAT_ARGB32, 64, 64);
+        }
+        REQUIRE(pool->FreeBytes() == 0);
+        REQUIRE(pool->PeakBytes() >= 300 * 200 * 4);
+    }
+    SECTION("Trim on idle")
+    {
+        pool->IdleTimeout(std::chrono::milliseconds(10));
+        pool->Trim();
+        REQUIRE(pool->FreeBytes() != 0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        pool->Trim();
+        REQUIRE(pool->FreeBytes() == 0);
+    }
+    SECTION("Surfaces outlive the pool")
+    {
+        Lv2cImageSurface surface = pool->Acquire(cairo_format_t::CAIRO_FORMAT_ARGB32, 32, 32);
+        pool = nullptr;
+        surface.get_data()[0] = 1;
+    }
+}
@@ -0,0 +1,218 @@
+// Copyright (c) 2023 Robin E. R. Davies
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <cmath>
+#include <bit>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace lv2
+{
+	/// @brief Peak or RMS level meter for VU output ports.
+	///
+	/// Levels are integrated over a window that is independent of the host's block size, and the
+	/// output port is written at most updateHz times per second, so meters update at UI rate rather
+	/// than on every Run(). Real-time safe: no allocations or locks, and no log10 per block.
+	class Lv2Meter
+	{
+	public:
+		enum class Mode
+		{
+			Peak,
+			Rms
+		};
+		static constexpr float MIN_DB = -96.0f;
+
+		void Prepare(double sampleRate, Mode mode = Mode::Peak, double integrationSeconds = 0.05, double updateHz = 30)
+		{
+			this->mode = mode;
+			windowSamples = std::max((uint32_t)(sampleRate * integrationSeconds), (uint32_t)1);
+			updateSamples = std::max((uint32_t)(sampleRate / updateHz), (uint32_t)1);
+			Reset();
+		}
+		void Reset()
+		{
+			windowPosition = 0;
+			windowPeak = 0;
+			windowSumOfSquares = 0;
+			pendingLevel = 0;
+			hasPendingLevel = false;
+			samplesSinceUpdate = updateSamples; // update on the first call.
+		}
+
+		/// @brief Accumulate a buffer.
+		/// @param gain Applied to the input before metering (e.g. a level control that hasn't been applied to the buffer).
+		void Process(const float *input, uint32_t n_samples, float gain = 1.0f)
+		{
+			samplesSinceUpdate += n_samples;
+			float absGain = std::abs(gain);
+			while (n_samples != 0)
+			{
+				uint32_t n = std::min(n_samples, windowSamples - windowPosition);
+				if (mode == Mode::Peak)
+				{
+					windowPeak = std::max(windowPeak, Peak(input, n) * absGain);
+				}
+				else
+				{
+					windowSumOfSquares += SumOfSquares(input, n) * absGain * absGain;
+				}
+				input += n;
+				n_samples -= n;
+				windowPosition += n;
+				if (windowPosition == windowSamples)
+				{
+					EndWindow();
+				}
+			}
+		}
+
+		/// @brief Write the current level (in dB) to an output port, if the update interval has elapsed.
+		/// @returns true if the port was written.
+		bool Update(float *outputPort)
+		{
+			if (samplesSinceUpdate < updateSamples || !hasPendingLevel || outputPort == nullptr)
+			{
+				return false;
+			}
+			*outputPort = FastDb(pendingLevel);
+			samplesSinceUpdate = 0;
+			hasPendingLevel = false;
+			pendingLevel = 0;
+			return true;
+		}
+
+		/// @brief Approximate 20*log10(amplitude). Max error about 0.05dB; exact for powers of two, so FastDb(1) == 0.
+		static float FastDb(float amplitude)
+		{
+			if (!(amplitude > MIN_DB_AMPLITUDE))
+			{
+				return MIN_DB;
+			}
+			// log2 from the float exponent, plus a quadratic over the mantissa that is exact at both ends of the octave.
+			uint32_t bits = std::bit_cast<uint32_t>(amplitude);
+			float exponent = (float)((int32_t)(bits >> 23) - 127);
+			float t = std::bit_cast<float>((bits & 0x007FFFFF) | 0x3F800000) - 1.0f; // [0,1)
+			float log2 = exponent + t * (-0.34655539f * (t - 1.0f) + 1.0f);
+			return std::max(log2 * 6.02059991f, MIN_DB); // 20*log10(2) dB per octave.
+		}
+
+		/// @brief Maximum absolute value of a buffer.
+		static float Peak(const float *input, size_t n)
+		{
+			size_t i = 0;
+			float peak = 0;
+#if defined(__SSE2__)
+			const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+			__m128 peak4 = _mm_setzero_ps();
+			for (; i + 4 <= n; i += 4)
+			{
+				peak4 = _mm_max_ps(peak4, _mm_and_ps(_mm_loadu_ps(input + i), absMask));
+			}
+			alignas(16) float lanes[4];
+			_mm_store_ps(lanes, peak4);
+			peak = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+#elif defined(__ARM_NEON)
+			float32x4_t peak4 = vdupq_n_f32(0);
+			for (; i + 4 <= n; i += 4)
+			{
+				peak4 = vmaxq_f32(peak4, vabsq_f32(vld1q_f32(input + i)));
+			}
+			float32x2_t peak2 = vpmax_f32(vget_low_f32(peak4), vget_high_f32(peak4));
+			peak = std::max(vget_lane_f32(peak2, 0), vget_lane_f32(peak2, 1));
+#endif
+			for (; i < n; ++i)
+			{
+				peak = std::max(peak, std::abs(input[i]));
+			}
+			return peak;
+		}
+
+		/// @brief Sum of the squares of a buffer.
+		static float SumOfSquares(const float *input, size_t n)
+		{
+			size_t i = 0;
+			float sum = 0;
+#if defined(__SSE2__)
+			__m128 sum4 = _mm_setzero_ps();
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 x = _mm_loadu_ps(input + i);
+				sum4 = _mm_add_ps(sum4, _mm_mul_ps(x, x));
+			}
+			alignas(16) float lanes[4];
+			_mm_store_ps(lanes, sum4);
+			sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#elif defined(__ARM_NEON)
+			float32x4_t sum4 = vdupq_n_f32(0);
+			for (; i + 4 <= n; i += 4)
+			{
+				float32x4_t x = vld1q_f32(input + i);
+				sum4 = vmlaq_f32(sum4, x, x);
+			}
+			float32x2_t sum2 = vadd_f32(vget_low_f32(sum4), vget_high_f32(sum4));
+			sum = vget_lane_f32(sum2, 0) + vget_lane_f32(sum2, 1);
+#endif
+			for (; i < n; ++i)
+			{
+				sum += input[i] * input[i];
+			}
+			return sum;
+		}
+
+	private:
+		static constexpr float MIN_DB_AMPLITUDE = 1.5849e-5f; // -96dB
+
+		void EndWindow()
+		{
+			float level;
+			if (mode == Mode::Peak)
+			{
+				level = windowPeak;
+			}
+			else
+			{
+				level = std::sqrt(windowSumOfSquares / windowSamples);
+			}
+			// peaks between port updates are held until the next update.
+			pendingLevel = (mode == Mode::Peak && hasPendingLevel) ? std::max(pendingLevel, level) : level;
+			hasPendingLevel = true;
+			windowPosition = 0;
+			windowPeak = 0;
+			windowSumOfSquares = 0;
+		}
+
+		Mode mode = Mode::Peak;
+		uint32_t windowSamples = 1;
+		uint32_t updateSamples = 1;
+		uint32_t windowPosition = 0;
+		uint32_t samplesSinceUpdate = 0;
+		float windowPeak = 0;
+		float windowSumOfSquares = 0;
+		float pendingLevel = 0;
+		bool hasPendingLevel = false;
+	};
+}
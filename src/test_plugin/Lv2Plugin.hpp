@@ -34,6 +34,7 @@
 #include <vector>
 #include <functional>
 #include <concepts>
+#include "Lv2Meter.hpp"
 
 
 namespace lv2
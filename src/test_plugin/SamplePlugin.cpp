@@ -32,6 +32,9 @@ SamplePlugin::SamplePlugin(
     const LV2_Feature *const *features)
     :super(rate,bundle_path,features)
 {
+    vuInMeter.Prepare(rate);
+    vuOutLMeter.Prepare(rate);
+    vuOutRMeter.Prepare(rate);
 }
 
 void SamplePlugin::ConnectPort(uint32_t port, void *data)
@@ -104,6 +107,9 @@ void SamplePlugin::Activate()
 {
     lfoPhase = 0;
     // lfoRate is in Hz.
+    vuInMeter.Reset();
+    vuOutLMeter.Reset();
+    vuOutRMeter.Reset();
 
     // not actually implemented. For demonstration purposes only.
     // Should reset EQ filters here. 
@@ -136,9 +142,8 @@ void SamplePlugin::Run(uint32_t n_samples)
     float *outL = this->outL;
     float *outR = this->outR;
 
-    float maxInput = 0;
-    float maxOutputL = 0;
-    float maxOutputR = 0;
+    // meter the input before the loop, since hosts may pass the same buffer for in and outL.
+    vuInMeter.Process(in, n_samples, amplitude);
 
     for (size_t i = 0; i < n_samples; ++i)
     {
@@ -159,8 +164,6 @@ void SamplePlugin::Run(uint32_t n_samples)
               
 
         float inValue = in[i]*amplitude;
-        float inAbs = std::abs(inValue);
-        if (inAbs > maxInput) maxInput = inAbs;
 
         float valueL  = lfoValueL *inValue ;
 
@@ -170,25 +173,18 @@ void SamplePlugin::Run(uint32_t n_samples)
         {
             outR[i] = valueR;
         }
-
-        float absValueL = std::abs(valueL);
-        if (absValueL > maxOutputL)
-        {
-            maxOutputL = absValueL;
-        }
-        float absValueR = std::abs(valueR);
-        if (absValueR > maxOutputR)
-        {
-            maxOutputR = absValueR;
-        }
     }
     // output controls.
     *lfoOut = (float)std::sin(lfoPhase)*lfoDepth; //(something pretty to display)
 
-    *vuIn =  std::log10(maxInput)*20;
-    
-    *vuOutL = std::log10(maxOutputL)*20;
-    *vuOutR = std::log10(maxOutputR)*20;
+    vuOutLMeter.Process(outL, n_samples);
+    if (outR)
+    {
+        vuOutRMeter.Process(outR, n_samples);
+    }
+    vuInMeter.Update(vuIn);
+    vuOutLMeter.Update(vuOutL);
+    vuOutRMeter.Update(vuOutR);
 } 
 
 void SamplePlugin::Deactivate()
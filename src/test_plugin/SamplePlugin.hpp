@@ -62,6 +62,9 @@ private:
 	float *outR = nullptr;
 
 	float amplitude = 1.0;
+	Lv2Meter vuInMeter;
+	Lv2Meter vuOutLMeter;
+	Lv2Meter vuOutRMeter;
 	float lfoPhase = 0;
 	static constexpr double UNINITIALIZED = 1E-180;
 	float lastLevel = UNINITIALIZED;